@@ -11,5 +11,9 @@
 #include "G8RTOS_Structures.h"
 #include "G8RTOS_CriticalSection.h"
 #include "G8RTOS_IPC.h"
+#include "G8RTOS_Memory.h"
+#include "G8RTOS_Seqlock.h"
+#include "G8RTOS_Partitions.h"
+#include "G8RTOS_Log.h"
 
 #endif /* G8RTOS_H_ */
@@ -0,0 +1,52 @@
+// G8RTOS_Atomic.h
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// LDREX/STREX helpers shared by the lock-free kernel paths
+
+#ifndef G8RTOS_ATOMIC_H_
+#define G8RTOS_ATOMIC_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+
+/************************************Includes***************************************/
+
+/********************************Public Functions***********************************/
+
+// Exclusive access to one 32-bit word. A store fails if anything else wrote
+// the word or the context switched since the load; PendSV_Handler clears the
+// monitor on every switch, so an interrupted sequence always retries.
+static inline uint32_t LoadExclusive(volatile void* address) {
+    uint32_t value;
+    __asm__ volatile("ldrex %0, [%1]" : "=r" (value) : "r" (address) : "memory");
+    return value;
+}
+
+// Returns 0 if the store succeeded
+static inline uint32_t StoreExclusive(volatile void* address, uint32_t value) {
+    uint32_t failed;
+    __asm__ volatile("strex %0, %2, [%1]" : "=&r" (failed) : "r" (address), "r" (value) : "memory");
+    return failed;
+}
+
+static inline void ClearExclusive(void) {
+    __asm__ volatile("clrex" ::: "memory");
+}
+
+// AtomicAdd
+// Adds to a word and returns the new value.
+// Param "address": Pointer to the word
+// Param int32_t "delta": value to add
+// Return: int32_t
+static inline int32_t AtomicAdd(volatile void* address, int32_t delta) {
+    int32_t value;
+    do {
+        value = (int32_t)LoadExclusive(address) + delta;
+    } while (StoreExclusive(address, value) != 0);
+    return value;
+}
+
+/********************************Public Functions***********************************/
+
+#endif /* G8RTOS_ATOMIC_H_ */
@@ -0,0 +1,58 @@
+// G8RTOS_Benchmark.c
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Counts L1 data cache refills per scheduler pass with the PMU event exposed by
+// the BSP's xpm_counter.h. Each pass starts with the L1 data cache flushed, so
+// the count is the number of cache lines one context switch has to pull in.
+
+#include "G8RTOS_Benchmark.h"
+
+/************************************Includes***************************************/
+
+#include "G8RTOS_CriticalSection.h"
+#include "xil_cache.h"
+#include "xil_printf.h"
+#include "xpm_counter.h"
+
+/********************************Public Functions***********************************/
+
+// G8RTOS_BenchmarkScheduler
+// Runs G8RTOS_Scheduler "passes" times from a cold L1 data cache and prints the
+// average refills per pass. Call after adding threads, either before
+// G8RTOS_Launch or from a thread. The running thread and handoff are restored.
+// Param uint32_t "passes": number of scheduler passes to measure
+// Return: int32_t, average refills per pass, -1 if no PMU counter is free
+int32_t G8RTOS_BenchmarkScheduler(uint32_t passes) {
+    uint32_t counter = Xpm_SetUpAnEvent(XPM_EVENT_DATA_CACHEREFILL);
+    uint32_t refills = 0;
+
+    if (counter == XPM_NO_COUNTERS_AVAILABLE || passes == 0) {
+        return -1;
+    }
+
+    int32_t status = StartCriticalSection();
+    tcb_t* running = CurrentlyRunningThread;
+    tcb_t* handoff = HandoffThread;
+
+    for (uint32_t i = 0; i < passes; i++) {
+        uint32_t start;
+        uint32_t end;
+
+        Xil_L1DCacheFlush();
+        HandoffThread = 0;
+        CurrentlyRunningThread = running;
+        Xpm_GetEventCounter(counter, &start);
+        G8RTOS_Scheduler();
+        Xpm_GetEventCounter(counter, &end);
+        refills += end - start;
+    }
+
+    CurrentlyRunningThread = running;
+    HandoffThread = handoff;
+    EndCriticalSection(status);
+
+    Xpm_DisableEvent(counter);
+    xil_printf("G8RTOS_BENCHMARK scheduler %d passes %d L1D refills/pass\r\n",
+               passes, refills / passes);
+    return refills / passes;
+}
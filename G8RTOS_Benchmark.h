@@ -0,0 +1,23 @@
+// G8RTOS_Benchmark.h
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Cache-miss benchmark for the scheduler using the Cortex-A9 PMU
+
+#ifndef G8RTOS_BENCHMARK_H_
+#define G8RTOS_BENCHMARK_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+
+#include "G8RTOS_Scheduler.h"
+
+/************************************Includes***************************************/
+
+/********************************Public Functions***********************************/
+
+int32_t G8RTOS_BenchmarkScheduler(uint32_t passes);
+
+/********************************Public Functions***********************************/
+
+#endif /* G8RTOS_BENCHMARK_H_ */
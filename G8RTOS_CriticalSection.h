@@ -26,7 +26,7 @@
 
 /********************************Public Variables***********************************/
 
-uint32_t IBit_State;
+extern uint32_t IBit_State;
 
 /********************************Public Variables***********************************/
 
@@ -8,7 +8,7 @@
 
 	.thumb		; Set to thumb mode
 	.align 2	; Align by 2 bytes (thumb mode uses allignment by 2 or 4)
-	.text		; Text section
+	.sect ".kernel_text"	; Kernel fast memory (see lscript.ld)
 
 ; Starts a critical section
 ; 	- Saves the state of the current PRIMASK (I-bit)
@@ -8,6 +8,10 @@
 /************************************Includes***************************************/
 
 #include "G8RTOS_Semaphores.h"
+#include "G8RTOS_CriticalSection.h"
+#include "G8RTOS_Memory.h"
+#include "G8RTOS_Partitions.h"
+#include "G8RTOS_Scheduler.h"
 
 /******************************Data Type Definitions********************************/
 
@@ -23,12 +27,69 @@ typedef struct G8RTOS_FIFO_t {
 
 } G8RTOS_FIFO_t;
 
+// Per-thread synchronous IPC state, indexed by thread ID
+typedef struct ipcThread_t {
+    struct tcb_t* tcb;
+    ipcMessage_t* message; //client: request, server: receive buffer
+    ipcMessage_t* reply; //client: where the reply goes
+    threadID_t client; //server: client that was received from
+    semaphore_t replyWait; //what a client is blocked on until replied to
+    ipcChannel_t* channel; //channel waited on as server or queued sender, 0 if none
+    struct ipcThread_t* nextSender;
+} ipcThread_t;
+
 
 /***********************************Externs*****************************************/
 
 /********************************Private Variables***********************************/
 
-static G8RTOS_FIFO_t FIFOs[MAX_NUMBER_OF_FIFOS];
+KERNEL_FAST_BSS static G8RTOS_FIFO_t FIFOs[MAX_NUMBER_OF_FIFOS];
+
+KERNEL_FAST_BSS static ipcThread_t ipcThreads[MAX_THREADS];
+
+/*******************************Private Functions***********************************/
+
+// ReadHead
+// Takes the value at the head of a FIFO. The caller must already have
+// taken one count of currentSize.
+// Param uint32_t "FIFO_index": Index of FIFO block
+// Return: int32_t
+static int32_t ReadHead(uint32_t FIFO_index) {
+   G8RTOS_WaitSemaphore(&FIFOs[FIFO_index].mutex);
+   int32_t val = *(FIFOs[FIFO_index].head);
+   (FIFOs[FIFO_index].head)++;
+   if (FIFOs[FIFO_index].head == &FIFOs[FIFO_index].buffer[FIFO_SIZE]){
+       FIFOs[FIFO_index].head = &FIFOs[FIFO_index].buffer[0];
+   }
+   G8RTOS_SignalSemaphore(&FIFOs[FIFO_index].mutex);
+   return val;
+}
+
+// SwitchTo
+// Hands the CPU straight to "target" if it is at least as important as the
+// running thread and its partition may run, skipping the scheduler's scan.
+// Must be called from inside a critical section.
+// Param "target": thread that was just made ready
+// Param bool "mustSwitch": the running thread is blocking
+// Return: void
+static void SwitchTo(tcb_t* target, bool mustSwitch) {
+    if (target->priority <= CurrentlyRunningThread->priority &&
+        (RunnablePartitions & (1 << target->partition))) {
+        HandoffThread = target;
+        G8RTOS_Yield();
+    }
+    else if (mustSwitch || target->priority < CurrentlyRunningThread->priority) {
+        G8RTOS_Yield();
+    }
+}
+
+// WaitUntilUnblocked
+// Waits for the context switch requested while blocking to be taken.
+// Param "self": running thread
+// Return: void
+static void WaitUntilUnblocked(tcb_t* self) {
+    while (((volatile tcb_t*)self)->blocked != 0);
+}
 
 
 /********************************Public Functions***********************************/
@@ -68,17 +129,26 @@ int32_t G8RTOS_ReadFIFO(uint32_t FIFO_index) {
         return -1;
     }
    G8RTOS_WaitSemaphore(&FIFOs[FIFO_index].currentSize); // don't read block thread if FIFO is empty
-   G8RTOS_WaitSemaphore(&FIFOs[FIFO_index].mutex);
-   int32_t val = *(FIFOs[FIFO_index].head);
-   (FIFOs[FIFO_index].head)++;
-   if (FIFOs[FIFO_index].head == &FIFOs[FIFO_index].buffer[FIFO_SIZE - 1]){
-       FIFOs[FIFO_index].head = &FIFOs[FIFO_index].buffer[0];
-   }
-   G8RTOS_SignalSemaphore(&FIFOs[FIFO_index].mutex);
-   return val;
+   return ReadHead(FIFO_index);
 
 }
 
+// G8RTOS_TryReadFIFO
+// Reads data from head pointer of FIFO without blocking on an empty FIFO.
+// Param uint32_t "FIFO_index": Index of FIFO block
+// Param int32_t* "data": where to store the value read
+// Return: bool, true if a value was read
+bool G8RTOS_TryReadFIFO(uint32_t FIFO_index, int32_t* data) {
+    if(FIFO_index >= MAX_NUMBER_OF_FIFOS){
+        return false;
+    }
+    if(!G8RTOS_TryWaitSemaphore(&FIFOs[FIFO_index].currentSize)){
+        return false;
+    }
+    *data = ReadHead(FIFO_index);
+    return true;
+}
+
 // G8RTOS_WriteFIFO
 // Writes data to tail of buffer.
 // 0 if no error, -1 if out of bounds, -2 if full
@@ -107,3 +177,175 @@ int32_t G8RTOS_WriteFIFO(uint32_t FIFO_index, uint32_t data) {
 
 }
 
+// G8RTOS_AddFIFOToWaitSet
+// Adds a FIFO to a wait set. G8RTOS_WaitAny returns this member once the
+// FIFO holds data.
+// Param "set": Pointer to wait set
+// Param uint32_t "FIFO_index": Index of FIFO block
+// Return: int32_t, index of the member in the set, -1 on error
+int32_t G8RTOS_AddFIFOToWaitSet(waitSet_t* set, uint32_t FIFO_index) {
+    if(FIFO_index >= MAX_NUMBER_OF_FIFOS){
+        return -1;
+    }
+    return G8RTOS_AddToWaitSet(set, &FIFOs[FIFO_index].currentSize);
+}
+
+// G8RTOS_InitChannel
+// Initializes a synchronous IPC channel with no server and no clients.
+// Param "channel": Pointer to channel
+// Return: void
+void G8RTOS_InitChannel(ipcChannel_t* channel) {
+    channel->server = 0;
+    channel->senders = 0;
+    channel->receiveWait = 0;
+}
+
+// G8RTOS_Send
+// Sends a message on a channel and blocks until the server replies. If the
+// server is already waiting the message is delivered and the CPU handed to
+// it directly.
+// Param "channel": Pointer to channel
+// Param "message": request to send
+// Param "reply": where the server's reply is stored
+// Return: int32_t, 0 if no error, -1 if called from the idle thread
+KERNEL_FAST_TEXT int32_t G8RTOS_Send(ipcChannel_t* channel, const ipcMessage_t* message, ipcMessage_t* reply) {
+    tcb_t* self = CurrentlyRunningThread;
+    if (self->ThreadID < 0 || self->ThreadID >= MAX_THREADS) {
+        return -1;
+    }
+    int32_t status = StartCriticalSection();
+    ipcThread_t* client = &ipcThreads[self->ThreadID];
+
+    client->tcb = self;
+    client->message = (ipcMessage_t*)message;
+    client->reply = reply;
+    client->nextSender = 0;
+    self->blocked = &client->replyWait; //until G8RTOS_Reply
+
+    if (channel->server != 0) {
+        // Server is waiting, deliver and run it
+        tcb_t* server = channel->server;
+        ipcThread_t* receiver = &ipcThreads[server->ThreadID];
+        channel->server = 0;
+        receiver->channel = 0;
+        *(receiver->message) = *message;
+        receiver->client = self->ThreadID;
+        server->blocked = 0;
+        SwitchTo(server, true);
+    }
+    else {
+        // Queue behind earlier clients
+        ipcThread_t** link = &channel->senders;
+        while (*link != 0) {
+            link = &(*link)->nextSender;
+        }
+        *link = client;
+        client->channel = channel;
+        G8RTOS_Yield();
+    }
+    EndCriticalSection(status);
+
+    WaitUntilUnblocked(self);
+    return 0;
+}
+
+// G8RTOS_Receive
+// Takes the oldest message sent on a channel, blocking until there is one.
+// The client stays blocked until G8RTOS_Reply.
+// Param "channel": Pointer to channel
+// Param "message": where the request is stored
+// Return: threadID_t, ID of the client to reply to, -1 if called from the
+//         idle thread
+KERNEL_FAST_TEXT threadID_t G8RTOS_Receive(ipcChannel_t* channel, ipcMessage_t* message) {
+    tcb_t* self = CurrentlyRunningThread;
+    if (self->ThreadID < 0 || self->ThreadID >= MAX_THREADS) {
+        return -1;
+    }
+    int32_t status = StartCriticalSection();
+    ipcThread_t* receiver = &ipcThreads[self->ThreadID];
+
+    if (channel->senders != 0) {
+        ipcThread_t* client = channel->senders;
+        channel->senders = client->nextSender;
+        client->channel = 0;
+        *message = *(client->message);
+        EndCriticalSection(status);
+        return client->tcb->ThreadID;
+    }
+
+    // No client yet, G8RTOS_Send fills the buffer and wakes this thread
+    receiver->tcb = self;
+    receiver->message = message;
+    receiver->channel = channel;
+    channel->server = self;
+    self->blocked = &channel->receiveWait;
+    G8RTOS_Yield();
+    EndCriticalSection(status);
+
+    WaitUntilUnblocked(self);
+    return receiver->client;
+}
+
+// G8RTOS_Reply
+// Replies to a client blocked in G8RTOS_Send and wakes it. The CPU goes
+// straight back to the client if it is at least as important as the server.
+// Param threadID_t "client": ID returned by G8RTOS_Receive
+// Param "reply": reply to copy to the client
+// Return: int32_t, 0 if no error, -1 if the client is not waiting for a reply
+KERNEL_FAST_TEXT int32_t G8RTOS_Reply(threadID_t client, const ipcMessage_t* reply) {
+    if (client < 0 || client >= MAX_THREADS) {
+        return -1;
+    }
+    int32_t status = StartCriticalSection();
+    ipcThread_t* sender = &ipcThreads[client];
+    if (sender->tcb == 0 || sender->tcb->blocked != &sender->replyWait) {
+        EndCriticalSection(status);
+        return -1;
+    }
+    *(sender->reply) = *reply;
+    sender->tcb->blocked = 0;
+    SwitchTo(sender->tcb, false);
+    EndCriticalSection(status);
+    return 0;
+}
+
+// G8RTOS_CancelIPC
+// Removes a thread from synchronous IPC: takes it off the channel it waits
+// on as server or is queued on as client, and drops any reply it waits for.
+// Called when a thread is killed so no message reaches a dead thread.
+// Param "thread": Pointer to the thread's TCB
+// Return: bool, true if the thread was blocked in synchronous IPC
+bool G8RTOS_CancelIPC(struct tcb_t* thread) {
+    if (thread->ThreadID < 0 || thread->ThreadID >= MAX_THREADS) {
+        return false;
+    }
+    bool found = false;
+    int32_t status = StartCriticalSection();
+    ipcThread_t* ipc = &ipcThreads[thread->ThreadID];
+    ipcChannel_t* channel = ipc->channel;
+
+    if (channel != 0) {
+        if (channel->server == thread) {
+            channel->server = 0;
+        }
+        ipcThread_t** link = &channel->senders;
+        while (*link != 0) {
+            if (*link == ipc) {
+                *link = ipc->nextSender;
+                break;
+            }
+            link = &(*link)->nextSender;
+        }
+        ipc->channel = 0;
+        found = true;
+    }
+    if (thread->blocked == &ipc->replyWait) {
+        found = true;
+    }
+    if (found) {
+        thread->blocked = 0;
+    }
+    ipc->tcb = 0; //a late G8RTOS_Reply finds no client
+    EndCriticalSection(status);
+    return found;
+}
@@ -8,9 +8,11 @@
 
 /************************************Includes***************************************/
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "./G8RTOS_Semaphores.h"
+#include "./G8RTOS_Structures.h"
 
 /************************************Includes***************************************/
 
@@ -19,12 +21,27 @@
 #define FIFO_SIZE 16
 #define MAX_NUMBER_OF_FIFOS 4
 
+#define IPC_MESSAGE_WORDS 4
+
 /*************************************Defines***************************************/
 
 /******************************Data Type Definitions********************************/
 /******************************Data Type Definitions********************************/
 
 /****************************Data Structure Definitions*****************************/
+
+// Synchronous IPC message, copied by value
+typedef struct ipcMessage_t {
+    uint32_t words[IPC_MESSAGE_WORDS];
+} ipcMessage_t;
+
+// Synchronous IPC channel - a server receives on it, clients send to it
+typedef struct ipcChannel_t {
+    struct tcb_t* server; //server blocked in G8RTOS_Receive, 0 if none
+    struct ipcThread_t* senders; //clients waiting for the server, oldest first
+    semaphore_t receiveWait; //what a waiting server is blocked on
+} ipcChannel_t;
+
 /****************************Data Structure Definitions*****************************/
 
 /********************************Public Variables***********************************/
@@ -34,7 +51,15 @@
 
 int32_t G8RTOS_InitFIFO(uint32_t FIFO_index);
 int32_t G8RTOS_ReadFIFO(uint32_t FIFO_index);
+bool G8RTOS_TryReadFIFO(uint32_t FIFO_index, int32_t* data);
 int32_t G8RTOS_WriteFIFO(uint32_t FIFO_index, uint32_t data);
+int32_t G8RTOS_AddFIFOToWaitSet(waitSet_t* set, uint32_t FIFO_index);
+
+void G8RTOS_InitChannel(ipcChannel_t* channel);
+int32_t G8RTOS_Send(ipcChannel_t* channel, const ipcMessage_t* message, ipcMessage_t* reply);
+threadID_t G8RTOS_Receive(ipcChannel_t* channel, ipcMessage_t* message);
+int32_t G8RTOS_Reply(threadID_t client, const ipcMessage_t* reply);
+bool G8RTOS_CancelIPC(struct tcb_t* thread);
 
 /********************************Public Functions***********************************/
 
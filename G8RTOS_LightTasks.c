@@ -0,0 +1,81 @@
+// G8RTOS_LightTasks.c
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Defines for the light task host
+
+#include "G8RTOS_LightTasks.h"
+
+/************************************Includes***************************************/
+
+#include <stdbool.h>
+
+#include "G8RTOS_CriticalSection.h"
+
+/********************************Public Functions***********************************/
+
+// G8RTOS_InitLightTaskHost
+// Initializes a host with no tasks.
+// Param "host": Pointer to light task host
+// Return: void
+void G8RTOS_InitLightTaskHost(lightTaskHost_t* host) {
+    host->tasks = 0;
+}
+
+// G8RTOS_AddLightTask
+// Adds a task to a host. Tasks may be added by the host's own tasks or by
+// other threads.
+// Param "host": Pointer to light task host
+// Param "task": Pointer to task control block, must stay valid until it exits
+// Param "function": task body
+// Param "context": passed to the task through task->context
+// Return: void
+void G8RTOS_AddLightTask(lightTaskHost_t* host, lightTask_t* task,
+                         uint8_t (*function)(lightTask_t* task), void* context) {
+    task->function = function;
+    task->context = context;
+    task->resumePoint = 0;
+    task->wakeTime = 0;
+
+    int32_t status = StartCriticalSection();
+    task->nextTask = host->tasks;
+    host->tasks = task;
+    EndCriticalSection(status);
+}
+
+// G8RTOS_RunLightTasks
+// Runs the host's tasks round robin, forever. Call it from the host thread.
+// Sleeps for a tick whenever a full pass makes no progress.
+// Param "host": Pointer to light task host
+// Return: void
+void G8RTOS_RunLightTasks(lightTaskHost_t* host) {
+    while (1) {
+        bool progress = false;
+        lightTask_t** link = &host->tasks;
+
+        while (*link != 0) {
+            lightTask_t* task = *link;
+            uint32_t resumePoint = task->resumePoint;
+            uint8_t result = task->function(task);
+
+            if (result == LIGHTTASK_EXITED) {
+                // Another thread may have added tasks in front of this one
+                int32_t status = StartCriticalSection();
+                while (*link != task) {
+                    link = &(*link)->nextTask;
+                }
+                *link = task->nextTask;
+                EndCriticalSection(status);
+                progress = true;
+                continue;
+            }
+            if (result == LIGHTTASK_YIELDED || task->resumePoint != resumePoint) {
+                progress = true;
+            }
+            link = &task->nextTask;
+        }
+
+        if (!progress) {
+            sleep(1);
+        }
+    }
+}
@@ -0,0 +1,98 @@
+// G8RTOS_LightTasks.h
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Stackless cooperative tasks that share the stack of one host thread
+
+#ifndef G8RTOS_LIGHTTASKS_H_
+#define G8RTOS_LIGHTTASKS_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+
+#include "G8RTOS_IPC.h"
+#include "G8RTOS_Scheduler.h"
+#include "G8RTOS_Semaphores.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// The host polls: a pass in which no task makes progress sleeps one tick, so
+// a host whose tasks all wait on semaphores or FIFOs still wakes every tick,
+// and a wait is noticed up to 1 ms after its condition holds. Use a full
+// thread for work that needs lower latency or a fully idle CPU.
+
+// Light task return values
+#define LIGHTTASK_WAITING   0
+#define LIGHTTASK_YIELDED   1
+#define LIGHTTASK_EXITED    2
+
+// A light task body is a function returning one of the values above, wrapped
+// in LIGHTTASK_BEGIN / LIGHTTASK_END. Local variables are not kept across a
+// wait or yield; keep state in the task's context. Do not use switch
+// statements around a wait.
+#define LIGHTTASK_BEGIN(t)      switch ((t)->resumePoint) { case 0:
+
+#define LIGHTTASK_END(t)        } (t)->resumePoint = 0; return LIGHTTASK_EXITED
+
+// Returns to the host until "condition" holds
+#define LIGHTTASK_WAIT_UNTIL(t, condition)              \
+    do {                                                \
+        (t)->resumePoint = __LINE__; case __LINE__:     \
+        if (!(condition)) {                             \
+            return LIGHTTASK_WAITING;                   \
+        }                                               \
+    } while (0)
+
+// Lets the other light tasks run once
+#define LIGHTTASK_YIELD(t)                              \
+    do {                                                \
+        (t)->resumePoint = __LINE__;                    \
+        return LIGHTTASK_YIELDED;                       \
+        case __LINE__:;                                 \
+    } while (0)
+
+#define LIGHTTASK_WAIT_SEMAPHORE(t, s)                  \
+    LIGHTTASK_WAIT_UNTIL(t, G8RTOS_TryWaitSemaphore(s))
+
+// Stores the value read in "data", which must not be a local variable
+#define LIGHTTASK_READ_FIFO(t, FIFO_index, data)        \
+    LIGHTTASK_WAIT_UNTIL(t, G8RTOS_TryReadFIFO(FIFO_index, &(data)))
+
+#define LIGHTTASK_SLEEP(t, durationMS)                  \
+    do {                                                \
+        (t)->wakeTime = GetSystemTime() + (durationMS); \
+        LIGHTTASK_WAIT_UNTIL(t, (int32_t)(GetSystemTime() - (t)->wakeTime) >= 0); \
+    } while (0)
+
+/*************************************Defines***************************************/
+
+/****************************Data Structure Definitions*****************************/
+
+// Light Task Control Block
+typedef struct lightTask_t {
+    uint8_t (*function)(struct lightTask_t* task);
+    void* context;
+    uint32_t resumePoint; //line to resume at, 0 to start over
+    uint32_t wakeTime;
+    struct lightTask_t* nextTask;
+} lightTask_t;
+
+// Light Task Host - the tasks run by one host thread
+typedef struct lightTaskHost_t {
+    lightTask_t* tasks;
+} lightTaskHost_t;
+
+/****************************Data Structure Definitions*****************************/
+
+/********************************Public Functions***********************************/
+
+void G8RTOS_InitLightTaskHost(lightTaskHost_t* host);
+void G8RTOS_AddLightTask(lightTaskHost_t* host, lightTask_t* task,
+                         uint8_t (*function)(lightTask_t* task), void* context);
+void G8RTOS_RunLightTasks(lightTaskHost_t* host);
+
+/********************************Public Functions***********************************/
+
+#endif /* G8RTOS_LIGHTTASKS_H_ */
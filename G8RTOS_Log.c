@@ -0,0 +1,125 @@
+// G8RTOS_Log.c
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Defines for deferred binary logging
+
+#include "G8RTOS_Log.h"
+
+/************************************Includes***************************************/
+
+#include "G8RTOS_Atomic.h"
+#include "G8RTOS_Memory.h"
+#include "G8RTOS_Scheduler.h"
+
+#include "xil_printf.h"
+
+/*************************************Defines***************************************/
+
+#define LOG_BUFFER_MASK         (LOG_BUFFER_WORDS - 1)
+
+_Static_assert((LOG_BUFFER_WORDS & LOG_BUFFER_MASK) == 0, "LOG_BUFFER_WORDS must be a power of two");
+
+/***********************************Externs*****************************************/
+
+extern uint32_t SystemTime;
+
+/********************************Private Variables**********************************/
+
+// Ring shared by all writers. Writers reserve space by advancing logHead
+// with LDREX/STREX and commit by writing the header last; only the drain
+// thread advances logTail.
+static uint32_t logBuffer[LOG_BUFFER_WORDS];
+KERNEL_FAST_BSS static uint32_t logHead;
+KERNEL_FAST_BSS static uint32_t logTail;
+KERNEL_FAST_BSS static uint32_t droppedRecords;
+
+/*******************************Private Functions***********************************/
+
+// SendWord
+// Writes a word to the console UART, least significant byte first.
+// Param uint32_t "word": word to send
+// Return: void
+static void SendWord(uint32_t word) {
+    for (uint32_t i = 0; i < 4; i++) {
+        outbyte((char)(word >> (8 * i)));
+    }
+}
+
+/********************************Public Functions***********************************/
+
+// G8RTOS_LogWrite
+// Stores one log record. Never blocks and never masks interrupts; the
+// record is dropped if the ring is full. Use G8RTOS_LOG instead of calling
+// this directly.
+// Param uint32_t "format": format string ID
+// Param uint32_t* "args": raw arguments
+// Param uint32_t "numberOfArgs": number of arguments, only the first
+//                                LOG_MAX_ARGS are stored
+// Return: void
+KERNEL_FAST_TEXT void G8RTOS_LogWrite(uint32_t format, const uint32_t* args, uint32_t numberOfArgs) {
+    if (numberOfArgs > LOG_MAX_ARGS) {
+        numberOfArgs = LOG_MAX_ARGS;
+    }
+    uint32_t words = LOG_HEADER_WORDS + numberOfArgs;
+    uint32_t head;
+
+    // Reserve space
+    do {
+        head = LoadExclusive(&logHead);
+        if (head + words - logTail > LOG_BUFFER_WORDS) {
+            ClearExclusive();
+            AtomicAdd(&droppedRecords, 1);
+            return;
+        }
+    } while (StoreExclusive(&logHead, head + words) != 0);
+
+    uint32_t threadID = LOG_NO_THREAD;
+    if (CurrentlyRunningThread != 0) {
+        threadID = CurrentlyRunningThread->ThreadID;
+    }
+
+    logBuffer[(head + 1) & LOG_BUFFER_MASK] = SystemTime;
+    logBuffer[(head + 2) & LOG_BUFFER_MASK] = format;
+    for (uint32_t i = 0; i < numberOfArgs; i++) {
+        logBuffer[(head + LOG_HEADER_WORDS + i) & LOG_BUFFER_MASK] = args[i];
+    }
+
+    // Commit, the drain thread waits for the header
+    __asm__ volatile("" ::: "memory");
+    *(volatile uint32_t*)&logBuffer[head & LOG_BUFFER_MASK] =
+        LOG_MAGIC | (numberOfArgs << 16) | (threadID & 0xFFFF);
+}
+
+// G8RTOS_LogDrainThread
+// Streams committed records over the console UART, oldest first. Add it as
+// a low priority thread. Reports dropped records with a LOG_DROPPED_FORMAT
+// record.
+// Return: void
+void G8RTOS_LogDrainThread(void) {
+    while (1) {
+        uint32_t header = *(volatile uint32_t*)&logBuffer[logTail & LOG_BUFFER_MASK];
+
+        if ((header & LOG_MAGIC_MASK) != LOG_MAGIC) {
+            // Empty, or the oldest record is not committed yet
+            if (droppedRecords != 0) {
+                uint32_t dropped = droppedRecords;
+                AtomicAdd(&droppedRecords, -(int32_t)dropped);
+                SendWord(LOG_MAGIC | (1 << 16) | LOG_NO_THREAD);
+                SendWord(SystemTime);
+                SendWord(LOG_DROPPED_FORMAT);
+                SendWord(dropped);
+            }
+            sleep(LOG_DRAIN_PERIOD_MS);
+            continue;
+        }
+
+        uint32_t words = LOG_HEADER_WORDS + ((header >> 16) & 0xFF);
+        for (uint32_t i = 0; i < words; i++) {
+            uint32_t* word = &logBuffer[(logTail + i) & LOG_BUFFER_MASK];
+            SendWord(*word);
+            *word = 0; //headers must read as uncommitted when reused
+        }
+        __asm__ volatile("" ::: "memory");
+        logTail += words;
+    }
+}
@@ -0,0 +1,73 @@
+// G8RTOS_Log.h
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Deferred binary logging. Threads store a format string ID and raw
+// arguments; a drain thread streams the records and tools/g8rtos_log.py
+// formats them on the host.
+
+#ifndef G8RTOS_LOG_H_
+#define G8RTOS_LOG_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+#define LOG_BUFFER_WORDS        1024    // power of two
+#define LOG_MAX_ARGS            6
+#define LOG_DRAIN_PERIOD_MS     10
+
+// Record: header, SystemTime, format string ID, arguments
+#define LOG_HEADER_WORDS        3
+#define LOG_MAGIC               0xA5000000
+#define LOG_MAGIC_MASK          0xFF000000
+#define LOG_NO_THREAD           0xFFFF
+
+// Format ID of the record the drain thread emits after records were dropped
+#define LOG_DROPPED_FORMAT      0xFFFFFFFF
+
+// G8RTOS_LOG("speed %d at %p", speed, pointer)
+// Each argument is cast to uint32_t, so integers and pointers can be logged;
+// %s prints the string's address, not its text. Format strings go to a
+// non-allocated ELF section, so they take no target memory and their address
+// serves as the ID.
+#define G8RTOS_LOG(format, ...)                                                 \
+    do {                                                                        \
+        static const char G8RTOS_logFormat[]                                    \
+            __attribute__((section(".g8rtos_log_strings"), used)) = format;     \
+        const uint32_t G8RTOS_logArgs[] = {LOG_CAST_ARGS(0, ##__VA_ARGS__)};    \
+        _Static_assert(sizeof(G8RTOS_logArgs) / sizeof(uint32_t) - 1 <= LOG_MAX_ARGS, \
+                       "too many G8RTOS_LOG arguments");                        \
+        G8RTOS_LogWrite((uint32_t)G8RTOS_logFormat, &G8RTOS_logArgs[1],         \
+                        sizeof(G8RTOS_logArgs) / sizeof(uint32_t) - 1);         \
+    } while (0)
+
+// LOG_CAST_ARGS(0, a, b) expands to 0, (uint32_t)(a), (uint32_t)(b). More
+// than LOG_MAX_ARGS arguments make an array the static assert rejects.
+#define LOG_CAST_0(z)                   z
+#define LOG_CAST_1(z, a)                LOG_CAST_0(z), (uint32_t)(a)
+#define LOG_CAST_2(z, a, b)             LOG_CAST_1(z, a), (uint32_t)(b)
+#define LOG_CAST_3(z, a, b, c)          LOG_CAST_2(z, a, b), (uint32_t)(c)
+#define LOG_CAST_4(z, a, b, c, d)       LOG_CAST_3(z, a, b, c), (uint32_t)(d)
+#define LOG_CAST_5(z, a, b, c, d, e)    LOG_CAST_4(z, a, b, c, d), (uint32_t)(e)
+#define LOG_CAST_6(z, a, b, c, d, e, f) LOG_CAST_5(z, a, b, c, d, e), (uint32_t)(f)
+#define LOG_CAST_TOO_MANY(...)          0, 0, 0, 0, 0, 0, 0, 0
+#define LOG_CAST_SELECT(_0, _1, _2, _3, _4, _5, _6, _7, name, ...) name
+#define LOG_CAST_ARGS(...)                                                      \
+    LOG_CAST_SELECT(__VA_ARGS__, LOG_CAST_TOO_MANY, LOG_CAST_6, LOG_CAST_5,     \
+                    LOG_CAST_4, LOG_CAST_3, LOG_CAST_2, LOG_CAST_1,             \
+                    LOG_CAST_0, 0)(__VA_ARGS__)
+
+/*************************************Defines***************************************/
+
+/********************************Public Functions***********************************/
+
+void G8RTOS_LogWrite(uint32_t format, const uint32_t* args, uint32_t numberOfArgs);
+void G8RTOS_LogDrainThread(void);
+
+/********************************Public Functions***********************************/
+
+#endif /* G8RTOS_LOG_H_ */
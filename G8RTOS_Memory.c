@@ -0,0 +1,74 @@
+// G8RTOS_Memory.c
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Kernel fast memory initialization and L2 cache lockdown
+
+#include "G8RTOS_Memory.h"
+
+/************************************Includes***************************************/
+
+#include "G8RTOS_CriticalSection.h"
+#include "xil_cache.h"
+#include "xil_io.h"
+#include "xparameters_ps.h"
+#include "xpseudo_asm.h"
+
+/***********************************Externs*****************************************/
+
+// Defined in lscript.ld
+extern uint8_t __kernel_fast_start[];
+extern uint8_t __kernel_fast_bss_start[];
+extern uint8_t __kernel_fast_bss_end[];
+
+/********************************Public Functions***********************************/
+
+// G8RTOS_InitFastMemory
+// Zeroes the kernel fast bss. The BSP startup code only clears .bss and .sbss.
+// Return: void
+void G8RTOS_InitFastMemory(void) {
+    for (uint8_t* p = __kernel_fast_bss_start; p < __kernel_fast_bss_end; p++) {
+        *p = 0;
+    }
+}
+
+// G8RTOS_LockKernelInL2
+// Loads the kernel fast memory region into dedicated L2 ways and locks them,
+// so other traffic cannot evict it. Only useful when the region is linked to
+// DDR; OCM accesses bypass the L2. Interrupts are held off during the fill so
+// no handler allocates its own lines into the ways being locked.
+// Return: int32_t, number of ways locked, -1 if region is not in DDR or too big
+int32_t G8RTOS_LockKernelInL2(void) {
+    uint32_t start = (uint32_t)__kernel_fast_start;
+    uint32_t size = (uint32_t)__kernel_fast_bss_end - start;
+    uint32_t ways = (size + L2CC_WAY_SIZE - 1) / L2CC_WAY_SIZE;
+
+    // Always leave at least one way for everything else
+    if (start < DDR_BASE_ADDRESS || ways == 0 || ways >= L2CC_NUMBER_OF_WAYS) {
+        return -1;
+    }
+    uint32_t lockedWays = (1 << ways) - 1;
+
+    int32_t status = StartCriticalSection();
+
+    // Push the region out of both cache levels so the loads below allocate
+    Xil_DCacheFlushRange(start, size);
+
+    // Only allow allocation into the ways being locked
+    Xil_Out32(XPS_L2CC_BASEADDR + L2CC_D_LOCKDOWN0, 0xFF & ~lockedWays);
+    Xil_Out32(XPS_L2CC_BASEADDR + L2CC_I_LOCKDOWN0, 0xFF & ~lockedWays);
+    dsb();
+
+    // Touch every line once
+    for (uint32_t addr = start; addr < start + size; addr += L2CC_LINE_SIZE) {
+        (void)*(volatile uint32_t*)addr;
+    }
+    dsb();
+
+    // Lock the filled ways, release the rest
+    Xil_Out32(XPS_L2CC_BASEADDR + L2CC_D_LOCKDOWN0, lockedWays);
+    Xil_Out32(XPS_L2CC_BASEADDR + L2CC_I_LOCKDOWN0, lockedWays);
+    dsb();
+
+    EndCriticalSection(status);
+    return ways;
+}
@@ -0,0 +1,56 @@
+// G8RTOS_Memory.h
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Kernel fast memory placement and L2 cache lockdown
+
+#ifndef G8RTOS_MEMORY_H_
+#define G8RTOS_MEMORY_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// Section attributes for the kernel fast memory region (see lscript.ld).
+// Define G8RTOS_NO_FAST_MEMORY to leave everything in the default sections.
+#ifndef G8RTOS_NO_FAST_MEMORY
+#define KERNEL_FAST_TEXT    __attribute__((section(".kernel_text")))
+#define KERNEL_FAST_DATA    __attribute__((section(".kernel_data")))
+#define KERNEL_FAST_BSS     __attribute__((section(".kernel_bss")))
+#else
+#define KERNEL_FAST_TEXT
+#define KERNEL_FAST_DATA
+#define KERNEL_FAST_BSS
+#endif
+
+// Define G8RTOS_FAST_STACKS to place the thread stacks in fast memory too.
+// The high OCM holds about 63 KB, too little for stacks with G8RTOS_STACK_GUARD.
+#ifdef G8RTOS_FAST_STACKS
+#define KERNEL_FAST_STACK   KERNEL_FAST_BSS
+#else
+#define KERNEL_FAST_STACK
+#endif
+
+// PL310 L2 cache controller
+#define L2CC_WAY_SIZE           0x10000     // 512 KB / 8 ways
+#define L2CC_NUMBER_OF_WAYS     8
+#define L2CC_LINE_SIZE          32
+#define L2CC_D_LOCKDOWN0        0x900
+#define L2CC_I_LOCKDOWN0        0x904
+
+// First DDR address; OCM is not cached by the L2
+#define DDR_BASE_ADDRESS        0x100000
+
+/*************************************Defines***************************************/
+
+/********************************Public Functions***********************************/
+
+void G8RTOS_InitFastMemory(void);
+int32_t G8RTOS_LockKernelInL2(void);
+
+/********************************Public Functions***********************************/
+
+#endif /* G8RTOS_MEMORY_H_ */
@@ -0,0 +1,213 @@
+// G8RTOS_Partitions.c
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// A fixed major frame is split into windows, each owned by one partition.
+// G8RTOS_Scheduler only picks threads from the partition owning the current
+// window, and a partition that spends its budget is stopped until the next
+// major frame. Background partitions can be given the unused time.
+
+#include "G8RTOS_Partitions.h"
+
+/************************************Includes***************************************/
+
+#include "G8RTOS_CriticalSection.h"
+#include "G8RTOS_Memory.h"
+
+/********************************Private Variables**********************************/
+
+static partition_t partitions[MAX_PARTITIONS];
+static partitionWindow_t windows[MAX_PARTITION_WINDOWS];
+static uint32_t NumberOfWindows;
+
+KERNEL_FAST_BSS static bool partitionsEnabled;
+KERNEL_FAST_BSS static bool slackDonation;
+KERNEL_FAST_BSS static uint32_t currentWindow;
+KERNEL_FAST_BSS static uint32_t windowTicksLeft;
+KERNEL_FAST_BSS static uint32_t exhaustedPartitions;
+
+/********************************Public Variables***********************************/
+
+// Everything may run until G8RTOS_StartPartitions
+KERNEL_FAST_DATA uint32_t RunnablePartitions = 0xFFFFFFFF;
+KERNEL_FAST_BSS uint32_t SlackPartitions;
+
+/*******************************Private Functions***********************************/
+
+// UpdateRunnablePartitions
+// Recomputes the partition masks read by G8RTOS_Scheduler.
+// Return: void
+static void UpdateRunnablePartitions(void) {
+    uint8_t active = windows[currentWindow].partition;
+    uint32_t background = 0;
+
+    RunnablePartitions = (1 << active) & ~exhaustedPartitions;
+    if (slackDonation) {
+        for (uint8_t i = 0; i < MAX_PARTITIONS; i++) {
+            if (partitions[i].background) {
+                background |= 1 << i;
+            }
+        }
+    }
+    SlackPartitions = background;
+}
+
+// ResetBudgets
+// Starts a new major frame's accounting. A partition with no budget is
+// exhausted from the start.
+// Return: void
+static void ResetBudgets(void) {
+    exhaustedPartitions = 0;
+    for (uint8_t i = 0; i < MAX_PARTITIONS; i++) {
+        partitions[i].used = 0;
+        partitions[i].elapsed = 0;
+        if (partitions[i].budget == 0) {
+            exhaustedPartitions |= 1 << i;
+        }
+    }
+}
+
+/********************************Public Functions***********************************/
+
+// G8RTOS_AddPartitionWindow
+// Appends a window to the major frame. The partition's budget grows by the
+// window's duration unless G8RTOS_SetPartitionBudget sets it later.
+// Param uint8_t "partition": partition owning the window
+// Param uint32_t "durationMS": length of the window in ticks
+// Return: sched_ErrCode_t
+sched_ErrCode_t G8RTOS_AddPartitionWindow(uint8_t partition, uint32_t durationMS) {
+    if (partition >= MAX_PARTITIONS || durationMS == 0) {
+        return PARTITION_INVALID;
+    }
+    if (partitionsEnabled || NumberOfWindows >= MAX_PARTITION_WINDOWS) {
+        return WINDOW_LIMIT_REACHED;
+    }
+    windows[NumberOfWindows].partition = partition;
+    windows[NumberOfWindows].duration = durationMS;
+    NumberOfWindows++;
+    partitions[partition].budget += durationMS;
+    partitions[partition].windowTime += durationMS;
+    return NO_ERROR;
+}
+
+// G8RTOS_SetPartitionBudget
+// Sets how many ticks a partition may run per major frame. While partitions
+// are running the new budget applies to the current frame at once.
+// Param uint8_t "partition": partition to configure
+// Param uint32_t "budgetMS": budget in ticks
+// Return: sched_ErrCode_t
+sched_ErrCode_t G8RTOS_SetPartitionBudget(uint8_t partition, uint32_t budgetMS) {
+    if (partition >= MAX_PARTITIONS) {
+        return PARTITION_INVALID;
+    }
+    int32_t status = StartCriticalSection();
+    partitions[partition].budget = budgetMS;
+    if (partitionsEnabled) {
+        if (partitions[partition].used >= budgetMS) {
+            exhaustedPartitions |= 1 << partition;
+        }
+        else {
+            exhaustedPartitions &= ~(1 << partition);
+        }
+        UpdateRunnablePartitions();
+    }
+    EndCriticalSection(status);
+    return NO_ERROR;
+}
+
+// G8RTOS_SetBackgroundPartition
+// Marks a partition as background: with slack donation on, its threads run
+// whenever the window's owner has no ready thread or is out of budget.
+// Param uint8_t "partition": partition to configure
+// Param bool "background": true for a background partition
+// Return: sched_ErrCode_t
+sched_ErrCode_t G8RTOS_SetBackgroundPartition(uint8_t partition, bool background) {
+    if (partition >= MAX_PARTITIONS) {
+        return PARTITION_INVALID;
+    }
+    partitions[partition].background = background;
+    if (partitionsEnabled) {
+        int32_t status = StartCriticalSection();
+        UpdateRunnablePartitions();
+        EndCriticalSection(status);
+    }
+    return NO_ERROR;
+}
+
+// G8RTOS_StartPartitions
+// Starts the major frame at its first window. Threads are in partition 0
+// unless moved with G8RTOS_SetThreadPartition. Whenever no thread may run,
+// the scheduler runs the kernel idle thread.
+// Param bool "donateSlack": give unused window time to background partitions
+// Return: sched_ErrCode_t
+sched_ErrCode_t G8RTOS_StartPartitions(bool donateSlack) {
+    if (NumberOfWindows == 0) {
+        return WINDOW_LIMIT_REACHED;
+    }
+    int32_t status = StartCriticalSection();
+    slackDonation = donateSlack;
+    currentWindow = 0;
+    windowTicksLeft = windows[0].duration;
+    ResetBudgets();
+    partitionsEnabled = true;
+    UpdateRunnablePartitions();
+    EndCriticalSection(status);
+    return NO_ERROR;
+}
+
+// G8RTOS_PartitionTick
+// Charges the tick to the running partition if it owns the window, catches
+// budget overruns and advances the major frame. Called from SysTick_Handler.
+// Param uint8_t "runningPartition": partition of the thread that ran
+// Return: void
+KERNEL_FAST_TEXT void G8RTOS_PartitionTick(uint8_t runningPartition) {
+    if (!partitionsEnabled) {
+        return;
+    }
+
+    uint8_t owner = windows[currentWindow].partition;
+    partitions[owner].elapsed++;
+    if (runningPartition == owner) {
+        partition_t* partition = &partitions[owner];
+        partition->used++;
+        if (partition->used >= partition->budget && !(exhaustedPartitions & (1 << owner))) {
+            exhaustedPartitions |= 1 << owner;
+            // Only an overrun if window time is left that it may not use
+            if (partition->elapsed < partition->windowTime) {
+                partition->overruns++;
+                G8RTOS_PartitionOverrunHook(owner);
+            }
+        }
+    }
+
+    if (--windowTicksLeft == 0) {
+        currentWindow++;
+        if (currentWindow == NumberOfWindows) {
+            // New major frame, budgets start over
+            currentWindow = 0;
+            ResetBudgets();
+        }
+        windowTicksLeft = windows[currentWindow].duration;
+    }
+    UpdateRunnablePartitions();
+}
+
+// G8RTOS_GetPartitionOverruns
+// Gets how many major frames a partition ran out of budget in.
+// Param uint8_t "partition": partition to query
+// Return: uint32_t
+uint32_t G8RTOS_GetPartitionOverruns(uint8_t partition) {
+    if (partition >= MAX_PARTITIONS) {
+        return 0;
+    }
+    return partitions[partition].overruns;
+}
+
+// G8RTOS_PartitionOverrunHook
+// Called from SysTick_Handler when a partition runs out of budget while
+// it still owns window time.
+// Applications can override it, the default does nothing.
+// Param uint8_t "partition": partition that ran out
+// Return: void
+__attribute__((weak)) void G8RTOS_PartitionOverrunHook(uint8_t partition) {
+    (void)partition;
+}
@@ -0,0 +1,70 @@
+// G8RTOS_Partitions.h
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Time-partitioned major frame on top of the priority scheduler
+
+#ifndef G8RTOS_PARTITIONS_H_
+#define G8RTOS_PARTITIONS_H_
+
+/************************************Includes***************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "G8RTOS_Scheduler.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+#define MAX_PARTITIONS          8
+#define MAX_PARTITION_WINDOWS   16
+
+// Partition of the kernel idle thread. Owns no window and is never charged.
+#define IDLE_PARTITION          MAX_PARTITIONS
+
+/*************************************Defines***************************************/
+
+/****************************Data Structure Definitions*****************************/
+
+// Partition - CPU budget per major frame
+typedef struct partition_t {
+    uint32_t budget; //ticks per major frame
+    uint32_t used; //ticks used in the current major frame
+    uint32_t windowTime; //ticks of window owned per major frame
+    uint32_t elapsed; //ticks of window passed in the current major frame
+    uint32_t overruns; //major frames in which the budget ran out early
+    bool background; //may run in other partitions' slack
+} partition_t;
+
+// Partition Window - slice of the major frame owned by one partition
+typedef struct partitionWindow_t {
+    uint8_t partition;
+    uint32_t duration; //ticks
+} partitionWindow_t;
+
+/****************************Data Structure Definitions*****************************/
+
+/********************************Public Variables***********************************/
+
+// Partitions whose threads may run now, one bit per partition
+extern uint32_t RunnablePartitions;
+
+// Partitions that may run when no thread in RunnablePartitions is ready
+extern uint32_t SlackPartitions;
+
+/********************************Public Variables***********************************/
+
+/********************************Public Functions***********************************/
+
+sched_ErrCode_t G8RTOS_AddPartitionWindow(uint8_t partition, uint32_t durationMS);
+sched_ErrCode_t G8RTOS_SetPartitionBudget(uint8_t partition, uint32_t budgetMS);
+sched_ErrCode_t G8RTOS_SetBackgroundPartition(uint8_t partition, bool background);
+sched_ErrCode_t G8RTOS_StartPartitions(bool donateSlack);
+void G8RTOS_PartitionTick(uint8_t runningPartition);
+uint32_t G8RTOS_GetPartitionOverruns(uint8_t partition);
+void G8RTOS_PartitionOverrunHook(uint8_t partition);
+
+/********************************Public Functions***********************************/
+
+#endif /* G8RTOS_PARTITIONS_H_ */
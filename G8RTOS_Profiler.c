@@ -0,0 +1,194 @@
+// G8RTOS_Profiler.c
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// A triple timer counter interrupt samples the interrupted PC and the running
+// thread into per-thread histograms. tools/g8rtos_profile.py symbolizes the
+// output of G8RTOS_ProfilerDump against the ELF.
+
+#include "G8RTOS_Profiler.h"
+
+/************************************Includes***************************************/
+
+#include "xinterrupt_wrap.h"
+#include "xparameters.h"
+#include "xil_printf.h"
+#include "xttcps.h"
+
+/*************************************Defines***************************************/
+
+#define PROFILER_NUMBER_OF_REGIONS  2
+
+// Prescaler XTtcPs_CalcIntervalFromFreq returns for a rate it cannot produce
+#define PROFILER_BAD_PRESCALER      0xFF
+
+/****************************Data Structure Definitions*****************************/
+
+// Address range covered by the histogram
+typedef struct profilerRegion_t {
+    uint32_t start;
+    uint32_t end;
+    uint32_t firstBucket;
+} profilerRegion_t;
+
+/***********************************Externs*****************************************/
+
+// Defined in lscript.ld
+extern uint8_t __kernel_fast_start[];
+extern uint8_t __kernel_fast_bss_start[];
+extern uint8_t __text_start[];
+extern uint8_t __text_end[];
+extern uint32_t __irq_stack[];
+
+/********************************Private Variables**********************************/
+
+static XTtcPs profilerTimer;
+
+static profilerRegion_t regions[PROFILER_NUMBER_OF_REGIONS];
+static uint32_t bucketShift;
+static uint32_t sampleRate;
+
+static uint16_t histogram[PROFILER_ROWS][PROFILER_MAX_BUCKETS];
+static uint32_t sampleCount;
+static uint32_t droppedCount; //PC outside the regions or bucket saturated
+
+/*******************************Private Functions***********************************/
+
+// Profiler_InterruptHandler
+// Records one sample. The BSP IRQ vector pushes {r0-r3, r12, lr} at the top
+// of the IRQ stack first, and IRQs do not nest, so the interrupted PC is the
+// last word below __irq_stack, minus the IRQ return offset.
+// Param void* "data": timer instance
+// Return: void
+static void Profiler_InterruptHandler(void* data) {
+    XTtcPs* timer = (XTtcPs*)data;
+    XTtcPs_ClearInterruptStatus(timer, XTtcPs_GetInterruptStatus(timer));
+
+    uint32_t pc = __irq_stack[-1] - 4;
+    uint32_t row = MAX_THREADS;
+    if (CurrentlyRunningThread != 0) {
+        row = CurrentlyRunningThread->ThreadID;
+    }
+
+    sampleCount++;
+    for (uint32_t i = 0; i < PROFILER_NUMBER_OF_REGIONS; i++) {
+        if (pc >= regions[i].start && pc < regions[i].end) {
+            uint16_t* bucket = &histogram[row][regions[i].firstBucket +
+                                               ((pc - regions[i].start) >> bucketShift)];
+            if (*bucket != UINT16_MAX) {
+                (*bucket)++;
+                return;
+            }
+            break;
+        }
+    }
+    droppedCount++;
+}
+
+/********************************Public Functions***********************************/
+
+// G8RTOS_ProfilerInit
+// Sets up the sampling timer and its interrupt. Sampling starts with
+// G8RTOS_ProfilerStart.
+// Param uint32_t "sampleRateHz": samples per second
+// Return: int32_t, 0 if no error, -1 if the timer could not be set up or
+//         cannot produce the sample rate
+int32_t G8RTOS_ProfilerInit(uint32_t sampleRateHz) {
+    XTtcPs_Config* config = XTtcPs_LookupConfig(PROFILER_TTC_BASEADDR);
+    XInterval interval;
+    uint8_t prescaler;
+
+    if (sampleRateHz == 0 || config == 0 ||
+        XTtcPs_CfgInitialize(&profilerTimer, config, config->BaseAddress) != XST_SUCCESS) {
+        return -1;
+    }
+
+    regions[0].start = (uint32_t)__kernel_fast_start;
+    regions[0].end = (uint32_t)__kernel_fast_bss_start;
+    regions[1].start = (uint32_t)__text_start;
+    regions[1].end = (uint32_t)__text_end;
+
+    // Widen buckets until both regions fit
+    bucketShift = PROFILER_MIN_BUCKET_SHIFT;
+    while (1) {
+        uint32_t buckets = 0;
+        for (uint32_t i = 0; i < PROFILER_NUMBER_OF_REGIONS; i++) {
+            regions[i].firstBucket = buckets;
+            buckets += ((regions[i].end - regions[i].start) >> bucketShift) + 1;
+        }
+        if (buckets <= PROFILER_MAX_BUCKETS) {
+            break;
+        }
+        bucketShift++;
+    }
+
+    sampleRate = sampleRateHz;
+    XTtcPs_SetOptions(&profilerTimer, XTTCPS_OPTION_INTERVAL_MODE | XTTCPS_OPTION_WAVE_DISABLE);
+    XTtcPs_CalcIntervalFromFreq(&profilerTimer, sampleRateHz, &interval, &prescaler);
+    if (prescaler == PROFILER_BAD_PRESCALER) {
+        return -1; //rate out of the timer's range
+    }
+    XTtcPs_SetInterval(&profilerTimer, interval);
+    XTtcPs_SetPrescaler(&profilerTimer, prescaler);
+
+    if (XSetupInterruptSystem(&profilerTimer, Profiler_InterruptHandler, config->IntrId[0],
+                              config->IntrParent, XINTERRUPT_DEFAULT_PRIORITY) != XST_SUCCESS) {
+        return -1;
+    }
+    XTtcPs_EnableInterrupts(&profilerTimer, XTTCPS_IXR_INTERVAL_MASK);
+
+    G8RTOS_ProfilerReset();
+    return 0;
+}
+
+// G8RTOS_ProfilerStart
+// Starts sampling.
+// Return: void
+void G8RTOS_ProfilerStart(void) {
+    XTtcPs_Start(&profilerTimer);
+}
+
+// G8RTOS_ProfilerStop
+// Stops sampling. The histograms are kept.
+// Return: void
+void G8RTOS_ProfilerStop(void) {
+    XTtcPs_Stop(&profilerTimer);
+}
+
+// G8RTOS_ProfilerReset
+// Clears the histograms.
+// Return: void
+void G8RTOS_ProfilerReset(void) {
+    for (uint32_t row = 0; row < PROFILER_ROWS; row++) {
+        for (uint32_t i = 0; i < PROFILER_MAX_BUCKETS; i++) {
+            histogram[row][i] = 0;
+        }
+    }
+    sampleCount = 0;
+    droppedCount = 0;
+}
+
+// G8RTOS_ProfilerDump
+// Prints the non-empty buckets in the format read by tools/g8rtos_profile.py.
+// Call with the profiler stopped.
+// Return: void
+void G8RTOS_ProfilerDump(void) {
+    xil_printf("G8RTOS_PROFILE %d %d %d %d\r\n", sampleRate, bucketShift, sampleCount, droppedCount);
+    for (uint32_t i = 0; i < PROFILER_NUMBER_OF_REGIONS; i++) {
+        xil_printf("R %08x %08x %d\r\n", regions[i].start, regions[i].end, regions[i].firstBucket);
+    }
+    for (uint32_t row = 0; row < PROFILER_ROWS; row++) {
+        const char* name = G8RTOS_GetThreadName(row);
+        if (row == MAX_THREADS) {
+            name = "idle";
+        }
+        if (name != 0) {
+            xil_printf("T %d %s\r\n", row, name);
+        }
+        for (uint32_t i = 0; i < PROFILER_MAX_BUCKETS; i++) {
+            if (histogram[row][i] != 0) {
+                xil_printf("S %d %d %d\r\n", row, i, histogram[row][i]);
+            }
+        }
+    }
+    xil_printf("END\r\n");
+}
@@ -0,0 +1,46 @@
+// G8RTOS_Profiler.h
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Statistical PC-sampling profiler
+
+#ifndef G8RTOS_PROFILER_H_
+#define G8RTOS_PROFILER_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+
+#include "G8RTOS_Scheduler.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// Histogram size per thread. Buckets are widened at init until the kernel
+// fast memory and .text fit. Can be overridden from USER_COMPILE_DEFINITIONS.
+#ifndef PROFILER_MAX_BUCKETS
+#define PROFILER_MAX_BUCKETS        2048
+#endif
+#define PROFILER_MIN_BUCKET_SHIFT   4
+
+// One row per thread plus one for the idle thread (IDLE_THREAD_ID), which
+// also takes samples from before launch
+#define PROFILER_ROWS               (MAX_THREADS + 1)
+
+#ifndef PROFILER_TTC_BASEADDR
+#define PROFILER_TTC_BASEADDR       XPAR_XTTCPS_0_BASEADDR
+#endif
+
+/*************************************Defines***************************************/
+
+/********************************Public Functions***********************************/
+
+int32_t G8RTOS_ProfilerInit(uint32_t sampleRateHz);
+void G8RTOS_ProfilerStart(void);
+void G8RTOS_ProfilerStop(void);
+void G8RTOS_ProfilerReset(void);
+void G8RTOS_ProfilerDump(void);
+
+/********************************Public Functions***********************************/
+
+#endif /* G8RTOS_PROFILER_H_ */
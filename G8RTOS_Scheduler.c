@@ -7,32 +7,77 @@
 
 /************************************Includes***************************************/
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 #include "G8RTOS_CriticalSection.h"
+#include "G8RTOS_IPC.h"
+#include "G8RTOS_Memory.h"
+#include "G8RTOS_Partitions.h"
+#include "G8RTOS_StackGuard.h"
+#include "xil_exception.h"
+#include "xinterrupt_wrap.h"
+#include "xparameters.h"
+#include "xscugic.h"
 
+/****************************Data Structure Definitions*****************************/
 
+// Thread Stack - one slot of threadStacks, led by a guard page if enabled
+typedef struct threadStack_t {
+#ifdef G8RTOS_STACK_GUARD
+    uint8_t guard[GUARD_PAGE_SIZE];
+#endif
+    uint32_t stack[STACKSIZE];
+} STACK_ALIGNMENT threadStack_t;
+
+
+
+/***********************************Externs*****************************************/
+
+// Defined in lscript.ld
+extern uint32_t __irq_stack[];
 
 /********************************Private Variables**********************************/
 
 // Thread Control Blocks - array to hold information for each thread
-static tcb_t threadControlBlocks[MAX_THREADS];
+KERNEL_FAST_BSS static tcb_t threadControlBlocks[MAX_THREADS];
+
+// Thread Info - names and statistics, indexed like threadControlBlocks
+static tcbInfo_t threadInfo[MAX_THREADS];
 
 // Thread Stacks - array of arrays for individual stacks of each thread
-static uint32_t threadStacks[MAX_THREADS][STACKSIZE];
+KERNEL_FAST_STACK static threadStack_t threadStacks[MAX_THREADS];
+
+// Idle Thread - kernel owned, always runnable, not in the thread list
+KERNEL_FAST_BSS static tcb_t idleThread;
+KERNEL_FAST_STACK static uint32_t idleStack[IDLE_STACKSIZE];
 
 // Periodic Event Threads - array to hold pertinent information for each thread
-static ptcb_t pthreadControlBlocks[MAX_PTHREADS];
+KERNEL_FAST_BSS static ptcb_t pthreadControlBlocks[MAX_PTHREADS];
 
 // Current Number of Threads currently in the scheduler
-static uint32_t NumberOfThreads;
+KERNEL_FAST_BSS static uint32_t NumberOfThreads;
 
 // Current Number of Periodic Threads currently in the scheduler
-static uint32_t NumberOfPThreads;
+KERNEL_FAST_BSS static uint32_t NumberOfPThreads;
 
 static uint32_t threadCounter = 0;
 
+// Where ContextSwitch_Trampoline resumes the interrupted thread: PC (bit 0
+// set for Thumb) and CPSR. Referenced by name from its assembly.
+KERNEL_FAST_BSS uint32_t G8RTOS_switchReturn[2] __attribute__((used));
+
+#ifdef __ARM_FP
+// VFP registers d0-d31 and FPSCR of each thread, indexed by ThreadID
+#define VFP_CONTEXT_WORDS   65
+uint32_t G8RTOS_vfpContexts[MAX_THREADS + 1][VFP_CONTEXT_WORDS]
+    __attribute__((aligned(8), used));
+#endif
+
+// ContextSwitch_Trampoline reads ThreadID at this offset
+_Static_assert(offsetof(tcb_t, ThreadID) == 28, "tcb_t ThreadID offset changed");
+
 /*******************************Private Functions***********************************/
 
 // Occurs every 1 ms.
@@ -52,19 +97,152 @@ static void InitSysTick(void)
     //SysTickEnable();
 }
 
+// Runs when nothing else can, sleeping until the next interrupt.
+static void IdleThread(void)
+{
+    while (1) {
+        __asm__ volatile("wfi");
+    }
+}
+
+// Sets up the idle thread's TCB and initial stack. Its nextTCB points into
+// the thread list so searches that start from the running thread still work.
+static void InitIdleThread(void)
+{
+    idleStack[IDLE_STACKSIZE - 1] = THREAD_CPSR(IdleThread); //PSR
+    idleStack[IDLE_STACKSIZE - 2] = (uint32_t)IdleThread; //PC
+    idleStack[IDLE_STACKSIZE - 3] = (uint32_t)IdleThread; //LR
+    idleThread.stackPointer = &idleStack[IDLE_STACKSIZE - 16];
+    idleThread.nextTCB = &threadControlBlocks[0];
+    idleThread.previousTCB = &threadControlBlocks[0];
+    idleThread.blocked = 0;
+    idleThread.sleepCount = 0;
+    idleThread.priority = IDLE_PRIORITY;
+    idleThread.partition = IDLE_PARTITION;
+    idleThread.ThreadID = IDLE_THREAD_ID;
+    idleThread.state = TCB_STATE_ALIVE;
+}
+
+// Saves the running thread, runs G8RTOS_Scheduler and resumes the chosen
+// thread. Entered in ARM state from the IRQ return that
+// ContextSwitch_InterruptHandler redirects, so it runs in System mode on the
+// interrupted thread's stack after the BSP IRQ frame is gone. The frame it
+// saves matches the initial frames of G8RTOS_AddThread:
+// R4-R11, R0-R3, R12, LR, PC, CPSR.
+__attribute__((naked, target("arm"))) KERNEL_FAST_TEXT
+static void ContextSwitch_Trampoline(void)
+{
+    __asm__ volatile(
+        "cpsid i\n"
+        "sub sp, sp, #8\n"                     //PC and CPSR slots
+        "push {r0-r3, r12, lr}\n"
+        "push {r4-r11}\n"
+        "ldr r0, =G8RTOS_switchReturn\n"
+        "ldr r1, [r0]\n"
+        "str r1, [sp, #56]\n"
+        "ldr r1, [r0, #4]\n"
+        "str r1, [sp, #60]\n"
+        "ldr r0, =CurrentlyRunningThread\n"
+        "ldr r1, [r0]\n"
+        "str sp, [r1]\n"
+#ifdef __ARM_FP
+        "ldr r2, [r1, #28]\n"                  //ThreadID
+        "ldr r0, =G8RTOS_vfpContexts\n"
+        "mov r3, #260\n"
+        "mla r0, r2, r3, r0\n"
+        "vstmia r0!, {d0-d15}\n"
+        "vstmia r0!, {d16-d31}\n"
+        "vmrs r3, fpscr\n"
+        "str r3, [r0]\n"
+#endif
+        "bic sp, sp, #7\n"                     //AAPCS alignment for the call
+        "bl G8RTOS_Scheduler\n"
+        "ldr r0, =CurrentlyRunningThread\n"
+        "ldr r1, [r0]\n"
+        "ldr sp, [r1]\n"
+#ifdef __ARM_FP
+        "ldr r2, [r1, #28]\n"
+        "ldr r0, =G8RTOS_vfpContexts\n"
+        "mov r3, #260\n"
+        "mla r0, r2, r3, r0\n"
+        "vldmia r0!, {d0-d15}\n"
+        "vldmia r0!, {d16-d31}\n"
+        "ldr r3, [r0]\n"
+        "vmsr fpscr, r3\n"
+#endif
+        "pop {r4-r11}\n"
+        "ldr r0, [sp, #24]\n"                  //RFE takes a PC without the Thumb bit
+        "bic r0, r0, #1\n"
+        "str r0, [sp, #24]\n"
+        "pop {r0-r3, r12, lr}\n"
+        "rfeia sp!\n"                          //PC and CPSR, interrupts back on
+        ".ltorg\n"
+    );
+}
+
+// Handles the SGI raised by G8RTOS_Yield. Switching stacks here would pull
+// them out from under the BSP IRQ dispatch, so it only makes the interrupt
+// return into ContextSwitch_Trampoline. The BSP pushes {r0-r3, r12, lr} at the
+// top of the IRQ stack first and IRQs do not nest, so the return address is
+// the last word below __irq_stack and SPSR_irq still holds the thread's CPSR.
+static void ContextSwitch_InterruptHandler(void* data)
+{
+    (void)data;
+    uint32_t spsr;
+    uint32_t* returnAddress = &__irq_stack[-1];
+    uint32_t trampoline = (uint32_t)ContextSwitch_Trampoline + 4;
+
+    __asm__ volatile("mrs %0, spsr" : "=r" (spsr));
+
+    // Only threads are switched, and only once per pending request
+    if (CurrentlyRunningThread == 0 || (spsr & CPSR_MODE_MASK) != CPSR_MODE_SYS ||
+        *returnAddress == trampoline) {
+        return;
+    }
+
+    G8RTOS_switchReturn[0] = (*returnAddress - 4) | ((spsr & CPSR_THUMB) ? 1 : 0);
+    G8RTOS_switchReturn[1] = spsr;
+    *returnAddress = trampoline;
+    spsr &= ~CPSR_EXEC_STATE;
+    __asm__ volatile("msr spsr_cxsf, %0" : : "r" (spsr));
+}
+
+// Connects the context switch SGI raised by G8RTOS_Yield. Uses the GIC
+// instance shared with XSetupInterruptSystem users such as the profiler, so
+// their handlers stay registered. Interrupts stay masked until G8RTOS_Start.
+static int32_t InitContextSwitchInterrupt(void)
+{
+    if (XConfigInterruptCntrl(G8RTOS_INTC_PARENT) != XST_SUCCESS) {
+        return -1;
+    }
+    if (XScuGic_Connect(&XScuGicInstance, PENDSV_SGI_ID,
+                        ContextSwitch_InterruptHandler, 0) != XST_SUCCESS) {
+        return -1;
+    }
+    // Lowest deliverable priority, so the switch never preempts another handler
+    XScuGic_SetPriorityTriggerType(&XScuGicInstance, PENDSV_SGI_ID, PENDSV_PRIORITY, 0x3);
+    XScuGic_Enable(&XScuGicInstance, PENDSV_SGI_ID);
+    XRegisterInterruptHandler(0, G8RTOS_INTC_PARENT);
+    return 0;
+}
+
 
 /********************************Public Variables***********************************/
 
-uint32_t SystemTime;
+KERNEL_FAST_BSS uint32_t SystemTime;
+
+uint32_t IBit_State;
 
-tcb_t* CurrentlyRunningThread;
+KERNEL_FAST_BSS tcb_t* CurrentlyRunningThread;
+
+KERNEL_FAST_BSS tcb_t* HandoffThread;
 
 
 
 /********************************Public Functions***********************************/
 
 // SysTick_Handler
-// Increments system time, sets PendSV flag to start scheduler.
+// Increments system time, wakes sleeping threads and requests a context switch.
 // Return: void
 
 
@@ -74,7 +252,7 @@ uint32_t GetSystemTime(void){
 void RemovePThread(void){
     NumberOfPThreads--;
 }
-void SysTick_Handler() {
+KERNEL_FAST_TEXT void SysTick_Handler() {
     SystemTime++;
     //determine if a periodic thread should be run
     //traverse through the ptcb block
@@ -95,19 +273,25 @@ void SysTick_Handler() {
         if(threadControlBlocks[i].sleepCount > 0){
             threadControlBlocks[i].sleepCount--;
             if(threadControlBlocks[i].sleepCount == 0){
-                 threadControlBlocks[i].asleep = 0;
+                 threadControlBlocks[i].state &= ~TCB_STATE_ASLEEP;
              }
         }
     }
-    //HWREG(NVIC_INT_CTRL)|= NVIC_INT_CTRL_PEND_SV;
-
 
+    // Charge the tick and advance the major frame
+    G8RTOS_PartitionTick(CurrentlyRunningThread->partition);
+    // Sleepers may have woken and the window may have moved, so a pending
+    // handoff no longer picks the right thread; take a full scheduler pass
+    HandoffThread = 0;
+    G8RTOS_Yield();
 }
 
 // G8RTOS_Init
 // Initializes the RTOS by initializing system time.
-// Return: void
-void G8RTOS_Init() {
+// Return: int32_t, 0 if no error, -1 if the stack guard pages could not be set up
+int32_t G8RTOS_Init() {
+    G8RTOS_InitFastMemory();
+
     uint32_t newVTORTable = 0x20000000;
     uint32_t* newTable = (uint32_t*) newVTORTable;
     uint32_t* oldTable = (uint32_t*) 0;
@@ -121,17 +305,32 @@ void G8RTOS_Init() {
     SystemTime = 0;
     NumberOfThreads = 0;
     NumberOfPThreads = 0;
+    InitIdleThread();
+
+#ifdef G8RTOS_STACK_GUARD
+    if (G8RTOS_InitStackGuard(threadStacks, sizeof(threadStack_t), MAX_THREADS) != 0) {
+        return -1;
+    }
+#endif
+    return 0;
 }
 
 // G8RTOS_Launch
 // Launches the RTOS.
-// Return: error codes, 0 if none
+// Return: error codes, 0 if none, -1 if the context switch interrupt could not be set up
 int32_t G8RTOS_Launch() {
     // Initialize system tick
       InitSysTick();
-      // Set currently running thread to the first control block
-      //TODO: Implement the linked list properly
-      CurrentlyRunningThread = &threadControlBlocks[0];
+      // No switch may be taken before G8RTOS_Start, which unmasks interrupts
+      int32_t status = StartCriticalSection();
+      // Route G8RTOS_Yield's SGI to the context switch
+      if (InitContextSwitchInterrupt() != 0) {
+          EndCriticalSection(status);
+          return -1;
+      }
+      // Start with the best runnable thread, the idle thread if there is none
+      CurrentlyRunningThread = &idleThread;
+      G8RTOS_Scheduler();
       // Set interrupt priorities
 
          // Pendsv
@@ -146,31 +345,58 @@ int32_t G8RTOS_Launch() {
 }
 
 // G8RTOS_Scheduler
-// Chooses next thread in the TCB. This time uses priority scheduling.
+// Chooses next thread in the TCB. This time uses priority scheduling,
+// restricted to the partitions allowed to run in the current window.
 // Return: void
-void G8RTOS_Scheduler() {
+KERNEL_FAST_TEXT void G8RTOS_Scheduler() {
     // Using priority, determine the most eligible thread to run that
     // is not blocked or asleep. Set current thread to this thread's TCB.
 
+    //a direct handoff (synchronous IPC) skips the scan if still runnable
+    //and its partition may run now
+    tcb_t* handoff = HandoffThread;
+    HandoffThread = 0;
+    if(handoff != 0 && handoff->blocked == 0 &&
+       (handoff->state & (TCB_STATE_ALIVE | TCB_STATE_ASLEEP)) == TCB_STATE_ALIVE &&
+       (RunnablePartitions & (1 << handoff->partition))){
+#ifdef G8RTOS_SWITCH_STATS
+        if(handoff != CurrentlyRunningThread && handoff != &idleThread){
+            threadInfo[handoff - threadControlBlocks].switchCount++;
+        }
+#endif
+        CurrentlyRunningThread = handoff;
+        return;
+    }
+
     //make counter = 0
     uint32_t counter = 0;
 
     //make temporary pointer for iteration
     tcb_t* iterationThreadPointer = &threadControlBlocks[0];
 
-    //make temporary pointer for thread to use
-    tcb_t* threadToRun = iterationThreadPointer;
+    //make temporary pointers for thread to use and best thread for slack time
+    tcb_t* threadToRun = 0;
+    tcb_t* slackThread = 0;
 
     //iterate through all threads (while counter < NumberOfThreads)
     while(counter < NumberOfThreads){
 
-        //if thread not blocked and thread not and priority is higher than current
+        //if thread alive, not blocked, not asleep
         if(iterationThreadPointer->blocked == 0 &&
-           iterationThreadPointer->isAlive == 1 &&
-           iterationThreadPointer->asleep == 0 &&
-           iterationThreadPointer->priority < threadToRun->priority){
-            //set thread to run to iteration thread
-            threadToRun = iterationThreadPointer;
+           (iterationThreadPointer->state & (TCB_STATE_ALIVE | TCB_STATE_ASLEEP)) == TCB_STATE_ALIVE){
+            uint32_t partitionBit = 1 << iterationThreadPointer->partition;
+
+            //keep the highest priority thread of the running partitions
+            if(RunnablePartitions & partitionBit){
+                if(threadToRun == 0 || iterationThreadPointer->priority < threadToRun->priority){
+                    threadToRun = iterationThreadPointer;
+                }
+            }
+            else if(SlackPartitions & partitionBit){
+                if(slackThread == 0 || iterationThreadPointer->priority < slackThread->priority){
+                    slackThread = iterationThreadPointer;
+                }
+            }
         }
         //set thread to thread->next
         iterationThreadPointer = iterationThreadPointer->nextTCB;
@@ -179,7 +405,21 @@ void G8RTOS_Scheduler() {
         counter++;
     }
 
+    //nothing ready in the window, hand the slack to a background thread
+    if(threadToRun == 0){
+        threadToRun = slackThread;
+    }
+    //nothing runnable at all
+    if(threadToRun == 0){
+        threadToRun = &idleThread;
+    }
+
     //set the new currently running thread
+#ifdef G8RTOS_SWITCH_STATS
+    if(threadToRun != CurrentlyRunningThread && threadToRun != &idleThread){
+        threadInfo[threadToRun - threadControlBlocks].switchCount++;
+    }
+#endif
     CurrentlyRunningThread = threadToRun;
 
     return;
@@ -206,25 +446,29 @@ sched_ErrCode_t G8RTOS_AddThread(void (threadToAdd)(void), uint8_t priority, cha
     else {
         int index = -1;
         for (int i = 0; i < MAX_THREADS; i++) {
-            if (threadControlBlocks[i].isAlive == false) {
+            if (!(threadControlBlocks[i].state & TCB_STATE_ALIVE)) {
                 index = i;
                 break;
             }
         }
-        threadStacks[index][STACKSIZE - 1] = THUMBBIT; //sets PSR
-        threadStacks[index][STACKSIZE - 2] = (uint32_t)threadToAdd; //sets PC
-        threadControlBlocks[index].stackPointer = &threadStacks[index][STACKSIZE - 16];
+        threadStacks[index].stack[STACKSIZE - 1] = THREAD_CPSR(threadToAdd); //sets PSR
+        threadStacks[index].stack[STACKSIZE - 2] = (uint32_t)threadToAdd; //sets PC
+        threadControlBlocks[index].stackPointer = &threadStacks[index].stack[STACKSIZE - 16];
         threadControlBlocks[index].priority = priority;
+        threadControlBlocks[index].partition = 0;
         threadControlBlocks[index].ThreadID = index;
         for (int i = 0; i < MAX_NAME_LENGTH; i++) { //set thread name
-            threadControlBlocks[index].threadName[i] = name[i];
+            threadInfo[index].threadName[i] = name[i];
             if (name[i] == 0x00) { //null character
                 break; //if reached the end of name, exit
             }
         }
-        threadControlBlocks[index].isAlive = true;
+#ifdef G8RTOS_SWITCH_STATS
+        threadInfo[index].switchCount = 0;
+#endif
+        threadControlBlocks[index].state = TCB_STATE_ALIVE;
         if (NumberOfThreads == 0) { //note that index here would be 0
-            threadStacks[NumberOfThreads][STACKSIZE - 3] = (uint32_t)threadToAdd;
+            threadStacks[NumberOfThreads].stack[STACKSIZE - 3] = (uint32_t)threadToAdd;
             threadControlBlocks[0].nextTCB = &threadControlBlocks[0];
             threadControlBlocks[0].previousTCB = &threadControlBlocks[0];
         }
@@ -353,8 +597,10 @@ sched_ErrCode_t G8RTOS_KillThread(threadID_t threadID) {
               // mark as not alive, release the semaphore it is blocked on
               temp->previousTCB->nextTCB = temp->nextTCB;
               temp->nextTCB->previousTCB = temp->previousTCB;
+              G8RTOS_CancelWaitAny(temp);
+              G8RTOS_CancelIPC(temp);
               temp->blocked = 0;
-              temp->isAlive = 0;
+              temp->state = 0;
 
               NumberOfThreads--;
               EndCriticalSection(IBit_State);
@@ -385,15 +631,36 @@ sched_ErrCode_t G8RTOS_KillSelf() {
    // Kill the thread...
    CurrentlyRunningThread->previousTCB->nextTCB = CurrentlyRunningThread->nextTCB;
    CurrentlyRunningThread->nextTCB->previousTCB = CurrentlyRunningThread->previousTCB;
-   if (CurrentlyRunningThread->blocked != 0){
+   // wait set and IPC markers are not semaphores, just unlink the thread
+   bool waitSet = G8RTOS_CancelWaitAny(CurrentlyRunningThread);
+   bool ipc = G8RTOS_CancelIPC(CurrentlyRunningThread);
+   if (!waitSet && !ipc && CurrentlyRunningThread->blocked != 0){
        G8RTOS_SignalSemaphore(CurrentlyRunningThread->blocked);
    }
-   CurrentlyRunningThread->isAlive = 0;
+   CurrentlyRunningThread->state = 0;
 
    NumberOfThreads--;
+   G8RTOS_Yield();
    EndCriticalSection(status);
 
-   //HWREG(NVIC_INT_CTRL)|= NVIC_INT_CTRL_PEND_SV;
+   return NO_ERROR;
+}
+
+// G8RTOS_SetThreadPartition
+// Moves a thread into a time partition.
+// Param threadID_t "threadID": ID of thread to move
+// Param uint8_t "partition": partition, below MAX_PARTITIONS
+// Return: sched_ErrCode_t
+sched_ErrCode_t G8RTOS_SetThreadPartition(threadID_t threadID, uint8_t partition) {
+    if (partition >= MAX_PARTITIONS) {
+        return PARTITION_INVALID;
+    }
+    if (threadID < 0 || threadID >= MAX_THREADS ||
+        !(threadControlBlocks[threadID].state & TCB_STATE_ALIVE)) {
+        return THREAD_DOES_NOT_EXIST;
+    }
+    threadControlBlocks[threadID].partition = partition;
+    return NO_ERROR;
 }
 
 // sleep
@@ -403,10 +670,16 @@ void sleep(uint32_t durationMS) {
     // Update time to sleep to
     CurrentlyRunningThread->sleepCount = durationMS;
     // Set thread as asleep
-    CurrentlyRunningThread->asleep = 1;
-    //HWREG(NVIC_INT_CTRL)|= NVIC_INT_CTRL_PEND_SV;
-
+    CurrentlyRunningThread->state |= TCB_STATE_ASLEEP;
+    G8RTOS_Yield();
+}
 
+// G8RTOS_Yield
+// Requests a context switch. It is taken as soon as interrupts are enabled,
+// so the scheduler runs right away or at the end of the critical section.
+// Return: void
+KERNEL_FAST_TEXT void G8RTOS_Yield(void) {
+    *(volatile uint32_t*)(GIC_DIST_BASEADDR + GIC_SGI_TRIGGER) = GIC_SGI_TO_SELF | PENDSV_SGI_ID;
 }
 
 // G8RTOS_GetThreadID
@@ -416,6 +689,35 @@ threadID_t G8RTOS_GetThreadID(void) {
     return CurrentlyRunningThread->ThreadID;        //Returns the thread ID
 }
 
+// G8RTOS_GetThreadName
+// Gets the name of a thread.
+// Param threadID_t "threadID": ID of thread
+// Return: const char*, 0 if thread does not exist
+const char* G8RTOS_GetThreadName(threadID_t threadID) {
+    if (threadID < 0 || threadID >= MAX_THREADS ||
+        !(threadControlBlocks[threadID].state & TCB_STATE_ALIVE)) {
+        return 0;
+    }
+    return threadInfo[threadID].threadName;
+}
+
+// G8RTOS_GetSwitchCount
+// Gets how many times a thread has been switched in. Counting is only built
+// with G8RTOS_SWITCH_STATS, since it writes the cold side table on every switch.
+// Param threadID_t "threadID": ID of thread
+// Return: uint32_t, always 0 without G8RTOS_SWITCH_STATS
+uint32_t G8RTOS_GetSwitchCount(threadID_t threadID) {
+#ifdef G8RTOS_SWITCH_STATS
+    if (threadID < 0 || threadID >= MAX_THREADS) {
+        return 0;
+    }
+    return threadInfo[threadID].switchCount;
+#else
+    (void)threadID;
+    return 0;
+#endif
+}
+
 // G8RTOS_GetNumberOfThreads
 // Gets number of threads.
 // Return: uint32_t
@@ -425,22 +727,22 @@ uint32_t G8RTOS_GetNumberOfThreads(void) {
 
 void SetInitialStack(uint8_t i){
     // - Sets stack thread control block stack pointer to top of thread stack
-    threadControlBlocks[i].stackPointer = &threadStacks[i][STACKSIZE - 16];
-    //threadStacks[i][STACKSIZE - 2] set PC in AddThread
-    threadStacks[i][STACKSIZE - 1] = THUMBBIT; //PSR
-    threadStacks[i][STACKSIZE - 3] = 0x14141414; //LR (R14)
-    threadStacks[i][STACKSIZE - 4] = 0x16000000; //R12
-    threadStacks[i][STACKSIZE - 5] = 0x15000000; //R3
-    threadStacks[i][STACKSIZE - 6] = 0x14000000; //R2
-    threadStacks[i][STACKSIZE - 7] = 0x01010101; //R1
-    threadStacks[i][STACKSIZE - 8] = 0x00000000; //R0
-    threadStacks[i][STACKSIZE - 9]=  0x11001100; //R11
-    threadStacks[i][STACKSIZE - 10] = 0x10101010; //R10
-    threadStacks[i][STACKSIZE - 11] = 0x09909090; //R9
-    threadStacks[i][STACKSIZE - 12] = 0x08080808; //R8
-    threadStacks[i][STACKSIZE - 13] = 0x07070707; //R7
-    threadStacks[i][STACKSIZE - 14] = 0x06060606; //R6
-    threadStacks[i][STACKSIZE - 15] = 0x05050505; //R5
-    threadStacks[i][STACKSIZE - 16] = 0x04040404; //R4
+    threadControlBlocks[i].stackPointer = &threadStacks[i].stack[STACKSIZE - 16];
+    //threadStacks[i].stack[STACKSIZE - 2] set PC in AddThread
+    threadStacks[i].stack[STACKSIZE - 1] = CPSR_MODE_SYS | CPSR_THUMB; //PSR
+    threadStacks[i].stack[STACKSIZE - 3] = 0x14141414; //LR (R14)
+    threadStacks[i].stack[STACKSIZE - 4] = 0x16000000; //R12
+    threadStacks[i].stack[STACKSIZE - 5] = 0x15000000; //R3
+    threadStacks[i].stack[STACKSIZE - 6] = 0x14000000; //R2
+    threadStacks[i].stack[STACKSIZE - 7] = 0x01010101; //R1
+    threadStacks[i].stack[STACKSIZE - 8] = 0x00000000; //R0
+    threadStacks[i].stack[STACKSIZE - 9]=  0x11001100; //R11
+    threadStacks[i].stack[STACKSIZE - 10] = 0x10101010; //R10
+    threadStacks[i].stack[STACKSIZE - 11] = 0x09909090; //R9
+    threadStacks[i].stack[STACKSIZE - 12] = 0x08080808; //R8
+    threadStacks[i].stack[STACKSIZE - 13] = 0x07070707; //R7
+    threadStacks[i].stack[STACKSIZE - 14] = 0x06060606; //R6
+    threadStacks[i].stack[STACKSIZE - 15] = 0x05050505; //R5
+    threadStacks[i].stack[STACKSIZE - 16] = 0x04040404; //R4
 
 }
@@ -16,14 +16,37 @@
 
 /*************************************Defines***************************************/
 
-/* Status Register with the Thumb-bit Set */
-#define THUMBBIT            0x01000000
+/* Status register a thread starts with: System mode, interrupts enabled, and
+   the Thumb bit for a Thumb entry point (bit 0 of its address) */
+#define CPSR_MODE_MASK      0x1F
+#define CPSR_MODE_SYS       0x1F
+#define CPSR_THUMB          0x20
+#define CPSR_EXEC_STATE     0x0600FC20  // Thumb and IT bits
+#define THREAD_CPSR(entry)  (CPSR_MODE_SYS | (((uint32_t)(entry) & 1) ? CPSR_THUMB : 0))
 
 #define MAX_THREADS         10
 #define MAX_PTHREADS        3
 #define STACKSIZE           700
 #define OSINT_PRIORITY      7
 
+/* Kernel idle thread, run when no other thread is runnable */
+#define IDLE_STACKSIZE      64
+#define IDLE_PRIORITY       255
+#define IDLE_THREAD_ID      MAX_THREADS
+
+/* Context switch request: software generated interrupt to this CPU, connected
+   by G8RTOS_Launch. 0xE8 is the lowest priority that passes the 0xF0 priority
+   mask XScuGic sets up */
+#define GIC_DIST_BASEADDR   0xF8F01000
+#define GIC_SGI_TRIGGER     0xF00
+#define GIC_SGI_TO_SELF     0x02000000
+#define PENDSV_SGI_ID       0
+#define PENDSV_PRIORITY     0xE8
+
+#ifndef G8RTOS_INTC_PARENT
+#define G8RTOS_INTC_PARENT  XPAR_XSCUGIC_0_BASEADDR
+#endif
+
 /*************************************Defines***************************************/
 
 /******************************Data Type Definitions********************************/
@@ -38,7 +61,9 @@ typedef enum
     THREAD_DOES_NOT_EXIST = -4,
     CANNOT_KILL_LAST_THREAD = -5,
     IRQn_INVALID = -6,
-    HWI_PRIORITY_INVALID = -7
+    HWI_PRIORITY_INVALID = -7,
+    PARTITION_INVALID = -8,
+    WINDOW_LIMIT_REACHED = -9
 } sched_ErrCode_t;
 
 /******************************Data Type Definitions********************************/
@@ -50,6 +75,9 @@ typedef enum
 
 extern tcb_t* CurrentlyRunningThread;
 
+// Thread G8RTOS_Scheduler switches to without scanning, 0 if none
+extern tcb_t* HandoffThread;
+
 /********************************Public Variables***********************************/
 
 /********************************Public Functions***********************************/
@@ -59,7 +87,7 @@ extern void PendSV_Handler();
 
 void SysTick_Handler();
 
-void G8RTOS_Init();
+int32_t G8RTOS_Init();
 int32_t G8RTOS_Launch();
 void G8RTOS_Scheduler();
 
@@ -68,11 +96,17 @@ sched_ErrCode_t G8RTOS_Add_APeriodicEvent(void (*AthreadToAdd)(void), uint8_t pr
 sched_ErrCode_t G8RTOS_Add_PeriodicEvent(void (*PthreadToAdd)(void), uint32_t period, uint32_t execution);
 sched_ErrCode_t G8RTOS_KillThread(threadID_t threadID);
 sched_ErrCode_t G8RTOS_KillSelf();
+sched_ErrCode_t G8RTOS_SetThreadPartition(threadID_t threadID, uint8_t partition);
 
 void sleep(uint32_t durationMS);
+void G8RTOS_Yield(void);
+
+uint32_t GetSystemTime(void);
 
 threadID_t G8RTOS_GetThreadID();
 uint32_t G8RTOS_GetNumberOfThreads(void);
+const char* G8RTOS_GetThreadName(threadID_t threadID);
+uint32_t G8RTOS_GetSwitchCount(threadID_t threadID);
 void SetInitialStack(uint8_t i);
 
 /********************************Public Functions***********************************/
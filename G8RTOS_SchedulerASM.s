@@ -11,7 +11,7 @@
 
 	.thumb		; Set to thumb mode
 	.align 2	; Align by 2 bytes (thumb mode uses allignment by 2 or 4)
-	.text		; Text section
+	.sect ".kernel_text"	; Kernel fast memory (see lscript.ld)
 
 ; Need to have the address defined in file
 ; (label needs to be close enough to asm code to be reached with PC relative addressing)
@@ -54,6 +54,7 @@ G8RTOS_Start:
 PendSV_Handler:
 	.asmfunc
 	CPSID I ;Disable Interupts globally
+	CLREX ;Drop the interrupted thread's exclusive access (semaphore fast paths)
 	PUSH{R4-R11}
 	;get adress of Running ptr
 	LDR R0, RunningPtr
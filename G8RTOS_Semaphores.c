@@ -7,8 +7,15 @@
 
 /************************************Includes***************************************/
 
+#include "G8RTOS_Atomic.h"
 #include "G8RTOS_CriticalSection.h"
 #include "G8RTOS_Scheduler.h"
+#include "G8RTOS_Memory.h"
+
+/*************************************Defines***************************************/
+
+// Bits in the armed wait set member registry, at most 32
+#define ARMED_FILTER_BITS 32
 
 
 
@@ -18,6 +25,91 @@
 
 /***********************************Externs*****************************************/
 
+/********************************Private Variables**********************************/
+
+// Wait sets that currently have a blocked waiter
+KERNEL_FAST_BSS static waitSet_t* activeWaitSets;
+
+// Registry of semaphores that are members of an armed wait set, hashed by
+// address into one bit each. armedCount holds how many armed memberships map
+// to each bit. A collision only sends a signal down the slow path.
+KERNEL_FAST_BSS static uint32_t armedFilter;
+KERNEL_FAST_BSS static uint8_t armedCount[ARMED_FILTER_BITS];
+
+// Marker a thread blocks on while waiting on a wait set
+static semaphore_t waitSetBlocked;
+
+/*******************************Private Functions***********************************/
+
+// Bit of a semaphore in armedFilter
+static inline uint32_t ArmedBitIndex(semaphore_t* s) {
+    return ((uint32_t)s / sizeof(semaphore_t)) % ARMED_FILTER_BITS;
+}
+
+// UnlinkWaitSet
+// Removes a set from the active list and clears its waiter. Must be called
+// from inside a critical section.
+// Param "link": Pointer to the link that points at the set
+// Return: void
+static void UnlinkWaitSet(waitSet_t** link) {
+    waitSet_t* set = *link;
+    for (uint32_t i = 0; i < set->size; i++) {
+        uint32_t bit = ArmedBitIndex(set->members[i]);
+        if (--armedCount[bit] == 0) {
+            armedFilter &= ~(1 << bit);
+        }
+    }
+    set->waiter = 0;
+    *link = set->next;
+}
+
+// ArmWaitSet
+// Puts a set on the active list with a waiter and registers its members.
+// Must be called from inside a critical section.
+// Param "set": Pointer to wait set
+// Param "waiter": Thread blocking on the set
+// Return: void
+static void ArmWaitSet(waitSet_t* set, tcb_t* waiter) {
+    for (uint32_t i = 0; i < set->size; i++) {
+        uint32_t bit = ArmedBitIndex(set->members[i]);
+        armedCount[bit]++;
+        armedFilter |= 1 << bit;
+    }
+    set->waiter = waiter;
+    set->next = activeWaitSets;
+    activeWaitSets = set;
+}
+
+// WakeWaitSets
+// Wakes every wait set waiter that has "s" as a member. Must be called
+// from inside a critical section.
+// Param "s": Pointer to semaphore that became available
+// Return: void
+static void WakeWaitSets(semaphore_t* s) {
+    waitSet_t** link = &activeWaitSets;
+    while (*link != 0) {
+        waitSet_t* set = *link;
+        bool member = false;
+        for (uint32_t i = 0; i < set->size; i++) {
+            if (set->members[i] == s) {
+                member = true;
+                break;
+            }
+        }
+        if (member) {
+            set->waiter->blocked = 0; //wake up
+            if (set->waiter->priority < CurrentlyRunningThread->priority) {
+                HandoffThread = 0; //full scheduler pass instead
+                G8RTOS_Yield();
+            }
+            UnlinkWaitSet(link);
+        }
+        else {
+            link = &set->next;
+        }
+    }
+}
+
 /********************************Public Variables***********************************/
 
 /********************************Public Functions***********************************/
@@ -27,10 +119,9 @@
 // Param "value": Value to initialize semaphore to
 // Return: void
 void G8RTOS_InitSemaphore(semaphore_t* s, int32_t value) {
-    // Replace with code from lab 3
-    IBit_State = StartCriticalSection();
-    *s = value;
-    EndCriticalSection(IBit_State);
+    do {
+        LoadExclusive(s);
+    } while (StoreExclusive(s, value) != 0);
 }
 
 // G8RTOS_WaitSemaphore
@@ -38,16 +129,43 @@ void G8RTOS_InitSemaphore(semaphore_t* s, int32_t value) {
 // If the current resource is not available, block the current thread
 // Param "s": Pointer to semaphore
 // Return: void
-void G8RTOS_WaitSemaphore(semaphore_t* s) {
-    // add your code
-    IBit_State = StartCriticalSection();
-    (*s) = (*s) - 1;
-    if((*s) < 0){
+KERNEL_FAST_TEXT void G8RTOS_WaitSemaphore(semaphore_t* s) {
+    // Fast path: take an available count without masking interrupts
+    while (1) {
+        int32_t value = LoadExclusive(s);
+        if (value <= 0) {
+            ClearExclusive();
+            break;
+        }
+        if (StoreExclusive(s, value - 1) == 0) {
+            return;
+        }
+    }
+
+    // Slow path: this thread has to block
+    int32_t status = StartCriticalSection();
+    if(AtomicAdd(s, -1) < 0){
         CurrentlyRunningThread->blocked = s; //reason it is blocked
-        EndCriticalSection(IBit_State);
-        //HWREG(NVIC_INT_CTRL)|= NVIC_INT_CTRL_PEND_SV; //run pendsv handler
+        G8RTOS_Yield(); //switch out once interrupts are enabled
+    }
+    EndCriticalSection(status);
+}
+
+// G8RTOS_TryWaitSemaphore
+// Decrements the semaphore by 1 only if it is available. Never blocks.
+// Param "s": Pointer to semaphore
+// Return: bool, true if the semaphore was taken
+KERNEL_FAST_TEXT bool G8RTOS_TryWaitSemaphore(semaphore_t* s) {
+    while (1) {
+        int32_t value = LoadExclusive(s);
+        if (value <= 0) {
+            ClearExclusive();
+            return false;
+        }
+        if (StoreExclusive(s, value - 1) == 0) {
+            return true;
+        }
     }
-    EndCriticalSection(IBit_State);
 }
 
 // G8RTOS_SignalSemaphore
@@ -55,18 +173,119 @@ void G8RTOS_WaitSemaphore(semaphore_t* s) {
 // Unblocks all threads currently blocked on the semaphore.
 // Param "s": Pointer to semaphore
 // Return: void
-void G8RTOS_SignalSemaphore(semaphore_t* s) {
-    // add your code
+KERNEL_FAST_TEXT void G8RTOS_SignalSemaphore(semaphore_t* s) {
+    // Fast path: nobody is blocked on it and it is not in an armed wait set
+    uint32_t armedBit = 1 << ArmedBitIndex(s);
+    while (1) {
+        int32_t value = LoadExclusive(s);
+        if (value < 0 || (armedFilter & armedBit) != 0) {
+            ClearExclusive();
+            break;
+        }
+        if (StoreExclusive(s, value + 1) == 0) {
+            return;
+        }
+    }
+
+    // Slow path: wake a blocked thread or wait set
     tcb_t* pt;
-    IBit_State = StartCriticalSection();
-    (*s) = (*s) + 1;
-    if((*s) <= 0){
+    int32_t status = StartCriticalSection();
+    if(AtomicAdd(s, 1) <= 0){
         pt = CurrentlyRunningThread->nextTCB; // search for blocked tcb and wake up
         while(pt->blocked != s){
             pt = pt->nextTCB;
         }
         pt->blocked = 0; //wake up
+        if(pt->priority < CurrentlyRunningThread->priority){
+            HandoffThread = 0; //full scheduler pass instead
+            G8RTOS_Yield(); //run the woken thread now
+        }
+    }
+    else if((armedFilter & armedBit) != 0){
+        WakeWaitSets(s);
     }
-    EndCriticalSection(IBit_State);
+    EndCriticalSection(status);
+}
+
+// G8RTOS_InitWaitSet
+// Initializes an empty wait set.
+// Param "set": Pointer to wait set
+// Return: void
+void G8RTOS_InitWaitSet(waitSet_t* set) {
+    set->size = 0;
+    set->waiter = 0;
+    set->next = 0;
 }
 
+// G8RTOS_AddToWaitSet
+// Adds a semaphore to a wait set.
+// Param "set": Pointer to wait set
+// Param "s": Pointer to semaphore
+// Return: int32_t, index of the member in the set, -1 if the set is full
+int32_t G8RTOS_AddToWaitSet(waitSet_t* set, semaphore_t* s) {
+    if (set->size >= MAX_WAITSET_SIZE) {
+        return -1;
+    }
+    set->members[set->size] = s;
+    return set->size++;
+}
+
+// G8RTOS_WaitAny
+// Blocks until at least one member of the set is available. Does not take
+// the semaphore; the caller follows up with G8RTOS_WaitSemaphore or
+// G8RTOS_ReadFIFO, which will not block if it is the only consumer.
+// A set has at most one waiter; give each waiting thread its own set.
+// Param "set": Pointer to wait set
+// Return: int32_t, index of the available member, -1 if the set is empty
+//         or another thread is already waiting on it
+int32_t G8RTOS_WaitAny(waitSet_t* set) {
+    if (set->size == 0) {
+        return -1;
+    }
+    tcb_t* self = CurrentlyRunningThread;
+    while (1) {
+        int32_t status = StartCriticalSection();
+        if (set->waiter != 0) {
+            EndCriticalSection(status);
+            return -1;
+        }
+        for (uint32_t i = 0; i < set->size; i++) {
+            if (*(set->members[i]) > 0) {
+                EndCriticalSection(status);
+                return i;
+            }
+        }
+        // Nothing ready, block on the set until a member is signaled
+        ArmWaitSet(set, self);
+        self->blocked = &waitSetBlocked;
+        G8RTOS_Yield();
+        EndCriticalSection(status);
+
+        // The scheduler skips this thread until WakeWaitSets clears blocked
+        while (((volatile tcb_t*)self)->blocked != 0);
+    }
+}
+
+// G8RTOS_CancelWaitAny
+// Removes a thread from the wait set it is blocked on, if any. Called when
+// a thread is killed so the set does not keep a dead waiter.
+// Param "thread": Pointer to the thread's TCB
+// Return: bool, true if the thread was blocked on a wait set
+bool G8RTOS_CancelWaitAny(struct tcb_t* thread) {
+    bool found = false;
+    int32_t status = StartCriticalSection();
+    if (thread->blocked == &waitSetBlocked) {
+        waitSet_t** link = &activeWaitSets;
+        while (*link != 0) {
+            if ((*link)->waiter == thread) {
+                UnlinkWaitSet(link);
+                break;
+            }
+            link = &(*link)->next;
+        }
+        thread->blocked = 0;
+        found = true;
+    }
+    EndCriticalSection(status);
+    return found;
+}
@@ -8,11 +8,15 @@
 
 /************************************Includes***************************************/
 
+#include <stdbool.h>
 #include <stdint.h>
 
 /************************************Includes***************************************/
 
 /*************************************Defines***************************************/
+
+#define MAX_WAITSET_SIZE 8
+
 /*************************************Defines***************************************/
 
 /******************************Data Type Definitions********************************/
@@ -23,6 +27,15 @@ typedef int32_t semaphore_t;
 /******************************Data Type Definitions********************************/
 
 /****************************Data Structure Definitions*****************************/
+
+// Wait Set - lets one thread block until any member semaphore is available
+typedef struct waitSet_t {
+    semaphore_t* members[MAX_WAITSET_SIZE];
+    uint32_t size;
+    struct tcb_t* waiter; //thread blocked on the set, 0 if none
+    struct waitSet_t* next; //next set with a blocked waiter
+} waitSet_t;
+
 /****************************Data Structure Definitions*****************************/
 
 
@@ -30,8 +43,14 @@ typedef int32_t semaphore_t;
 
 void G8RTOS_InitSemaphore(semaphore_t* s, int32_t value);
 void G8RTOS_WaitSemaphore(semaphore_t* s);
+bool G8RTOS_TryWaitSemaphore(semaphore_t* s);
 void G8RTOS_SignalSemaphore(semaphore_t* s);
 
+void G8RTOS_InitWaitSet(waitSet_t* set);
+int32_t G8RTOS_AddToWaitSet(waitSet_t* set, semaphore_t* s);
+int32_t G8RTOS_WaitAny(waitSet_t* set);
+bool G8RTOS_CancelWaitAny(struct tcb_t* thread);
+
 /********************************Public Functions***********************************/
 
 /*******************************Private Variables***********************************/
@@ -0,0 +1,70 @@
+// G8RTOS_Seqlock.c
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Defines for seqlock functions
+
+#include "G8RTOS_Seqlock.h"
+
+/************************************Includes***************************************/
+
+#include <string.h>
+
+#include "xpseudo_asm.h"
+
+/********************************Public Functions***********************************/
+
+// G8RTOS_InitSeqlock
+// Initializes a seqlock over two caller-provided buffers. buffer0 holds the
+// initial snapshot.
+// Param "lock": Pointer to seqlock
+// Param "buffer0", "buffer1": Snapshot buffers, "size" bytes each
+// Param uint32_t "size": Size of one snapshot
+// Return: void
+void G8RTOS_InitSeqlock(seqlock_t* lock, void* buffer0, void* buffer1, uint32_t size) {
+    lock->buffers[0] = buffer0;
+    lock->buffers[1] = buffer1;
+    lock->size = size;
+    lock->sequence = 0;
+    dmb();
+}
+
+// G8RTOS_SeqlockWriteBegin
+// Starts a new snapshot. Returns the buffer to fill, preloaded with the
+// current snapshot. Only one thread may write.
+// Param "lock": Pointer to seqlock
+// Return: void*, buffer to write the new snapshot to
+void* G8RTOS_SeqlockWriteBegin(seqlock_t* lock) {
+    uint32_t current = lock->sequence >> 1;
+    void* buffer = lock->buffers[(current + 1) & 1];
+
+    lock->sequence++; //odd, readers still use the current buffer
+    dmb();
+    memcpy(buffer, lock->buffers[current & 1], lock->size);
+    return buffer;
+}
+
+// G8RTOS_SeqlockWriteEnd
+// Publishes the buffer returned by G8RTOS_SeqlockWriteBegin.
+// Param "lock": Pointer to seqlock
+// Return: void
+void G8RTOS_SeqlockWriteEnd(seqlock_t* lock) {
+    dmb();
+    lock->sequence++; //even, new snapshot is current
+}
+
+// G8RTOS_SeqlockRead
+// Copies the latest complete snapshot. Never blocks; only retries if the
+// writer published and started another snapshot during the copy.
+// Param "lock": Pointer to seqlock
+// Param "dest": Buffer to copy the snapshot to
+// Return: void
+void G8RTOS_SeqlockRead(seqlock_t* lock, void* dest) {
+    uint32_t start;
+    do {
+        start = lock->sequence & ~1U;
+        dmb();
+        memcpy(dest, lock->buffers[(start >> 1) & 1], lock->size);
+        dmb();
+        // The buffer is reused once the sequence reaches start + 3
+    } while (lock->sequence - start > 2);
+}
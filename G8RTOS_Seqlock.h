@@ -0,0 +1,36 @@
+// G8RTOS_Seqlock.h
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Double-buffered seqlock for single-writer, many-reader shared state
+
+#ifndef G8RTOS_SEQLOCK_H_
+#define G8RTOS_SEQLOCK_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+
+/************************************Includes***************************************/
+
+/****************************Data Structure Definitions*****************************/
+
+// Seqlock - sequence is even when stable, odd while the writer fills the
+// other buffer. Snapshot k lives in buffers[k & 1].
+typedef struct seqlock_t {
+    volatile uint32_t sequence;
+    void* buffers[2];
+    uint32_t size;
+} seqlock_t;
+
+/****************************Data Structure Definitions*****************************/
+
+/********************************Public Functions***********************************/
+
+void G8RTOS_InitSeqlock(seqlock_t* lock, void* buffer0, void* buffer1, uint32_t size);
+void* G8RTOS_SeqlockWriteBegin(seqlock_t* lock);
+void G8RTOS_SeqlockWriteEnd(seqlock_t* lock);
+void G8RTOS_SeqlockRead(seqlock_t* lock, void* dest);
+
+/********************************Public Functions***********************************/
+
+#endif /* G8RTOS_SEQLOCK_H_ */
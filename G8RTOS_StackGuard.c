@@ -0,0 +1,145 @@
+// G8RTOS_StackGuard.c
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// Remaps the thread stack area with 4 KB pages and unmaps one guard page
+// below each stack. An overflow raises a data abort that names the thread.
+
+#include "G8RTOS_StackGuard.h"
+
+/************************************Includes***************************************/
+
+#include "G8RTOS_Scheduler.h"
+
+#include "xil_cache.h"
+#include "xil_exception.h"
+#include "xil_printf.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+
+/*************************************Defines***************************************/
+
+#define SECTION_SIZE            0x100000
+#define PAGES_PER_SECTION       (SECTION_SIZE / GUARD_PAGE_SIZE)
+
+// Enough for a stack area spanning two 1 MB sections
+#define MAX_GUARDED_SECTIONS    2
+
+/***********************************Externs*****************************************/
+
+// First level translation table, defined by the BSP
+extern uint32_t MMUTable[];
+
+/********************************Private Variables**********************************/
+
+// Second level (coarse) tables for the sections holding the stacks
+static uint32_t pageTables[MAX_GUARDED_SECTIONS][PAGES_PER_SECTION] __attribute__((aligned(1024)));
+
+static uint32_t stacksStart;
+static uint32_t stacksSlotSize;
+static uint32_t stacksNumberOfSlots;
+
+/*******************************Private Functions***********************************/
+
+// SectionToSmallPage
+// Converts a 1 MB section descriptor into a 4 KB small page descriptor with
+// the same memory type and permissions.
+// Param uint32_t "section": first level section descriptor
+// Return: uint32_t
+static uint32_t SectionToSmallPage(uint32_t section) {
+    uint32_t page = 0x2;
+    page |= (section >> 4) & 0x1;           // XN
+    page |= section & 0xC;                  // C, B
+    page |= ((section >> 10) & 0x3) << 4;   // AP[1:0]
+    page |= ((section >> 12) & 0x7) << 6;   // TEX
+    page |= ((section >> 15) & 0x1) << 9;   // AP[2]
+    page |= ((section >> 16) & 0x1) << 10;  // S
+    page |= ((section >> 17) & 0x1) << 11;  // nG
+    return page;
+}
+
+// StackGuard_DataAbortHandler
+// Reports aborts that hit a guard page, then hands off to the overflow hook.
+// Param void* "data": unused
+// Return: void
+static void StackGuard_DataAbortHandler(void* data) {
+    (void)data;
+    uint32_t faultAddress = mfcp(XREG_CP15_DATA_FAULT_ADDRESS);
+    uint32_t offset = faultAddress - stacksStart;
+
+    if (faultAddress >= stacksStart && offset < stacksSlotSize * stacksNumberOfSlots &&
+        offset % stacksSlotSize < GUARD_PAGE_SIZE) {
+        threadID_t threadID = offset / stacksSlotSize;
+        const char* name = G8RTOS_GetThreadName(threadID);
+        xil_printf("G8RTOS: stack overflow in thread %d (%s) at 0x%08x\r\n",
+                   threadID, name ? name : "?", faultAddress);
+        G8RTOS_StackOverflowHook(threadID);
+    }
+    else {
+        xil_printf("G8RTOS: data abort at 0x%08x\r\n", faultAddress);
+    }
+    while (1);
+}
+
+/********************************Public Functions***********************************/
+
+// G8RTOS_InitStackGuard
+// Maps the stack area with small pages and leaves the first page of every
+// slot unmapped. Each slot must start with its guard page.
+// Param void* "stacks": start of the stack area, page aligned
+// Param uint32_t "slotSize": size of one guard page + stack slot
+// Param uint32_t "numberOfSlots": number of stack slots
+// Return: int32_t, 0 if no error, -1 if the area cannot be guarded
+int32_t G8RTOS_InitStackGuard(void* stacks, uint32_t slotSize, uint32_t numberOfSlots) {
+    uint32_t start = (uint32_t)stacks;
+    uint32_t end = start + slotSize * numberOfSlots;
+    uint32_t firstSection = start / SECTION_SIZE;
+    uint32_t lastSection = (end - 1) / SECTION_SIZE;
+
+    if (start % GUARD_PAGE_SIZE != 0 || slotSize % GUARD_PAGE_SIZE != 0 ||
+        lastSection - firstSection >= MAX_GUARDED_SECTIONS) {
+        return -1;
+    }
+
+    stacksStart = start;
+    stacksSlotSize = slotSize;
+    stacksNumberOfSlots = numberOfSlots;
+
+    for (uint32_t section = firstSection; section <= lastSection; section++) {
+        uint32_t* table = pageTables[section - firstSection];
+        uint32_t sectionEntry = MMUTable[section];
+        uint32_t pageAttributes = SectionToSmallPage(sectionEntry);
+
+        // Same mapping as the section, one page at a time
+        for (uint32_t page = 0; page < PAGES_PER_SECTION; page++) {
+            uint32_t address = section * SECTION_SIZE + page * GUARD_PAGE_SIZE;
+            table[page] = address | pageAttributes;
+            if (address >= start && address < end &&
+                (address - start) % slotSize == 0) {
+                table[page] = 0; //guard page, translation fault
+            }
+        }
+
+        // Coarse page table descriptor, keeping the section's domain and NS bit
+        MMUTable[section] = (uint32_t)table | (sectionEntry & 0x1E0) |
+                            (((sectionEntry >> 19) & 0x1) << 3) | 0x1;
+    }
+
+    Xil_DCacheFlush();
+    mtcp(XREG_CP15_INVAL_UTLB_UNLOCKED, 0);
+    mtcp(XREG_CP15_INVAL_BRANCH_ARRAY, 0);
+    dsb();
+    isb();
+
+    Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_DATA_ABORT_INT,
+                                 (Xil_ExceptionHandler)StackGuard_DataAbortHandler, 0);
+    return 0;
+}
+
+// G8RTOS_StackOverflowHook
+// Called from the data abort handler when a thread overflows its stack.
+// Applications can override it, the default does nothing.
+// Param threadID_t "threadID": ID of the offending thread
+// Return: void
+__attribute__((weak)) void G8RTOS_StackOverflowHook(threadID_t threadID) {
+    (void)threadID;
+}
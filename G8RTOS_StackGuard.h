@@ -0,0 +1,38 @@
+// G8RTOS_StackGuard.h
+// Date Created: 2026-10-18
+// Date Updated: 2026-10-18
+// MMU guard pages below thread stacks
+
+#ifndef G8RTOS_STACKGUARD_H_
+#define G8RTOS_STACKGUARD_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+
+#include "G8RTOS_Structures.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// Define G8RTOS_STACK_GUARD to put a no-access page below every thread stack.
+// Each stack slot then takes a guard page plus the stack rounded up to a page.
+#define GUARD_PAGE_SIZE         4096
+
+#ifdef G8RTOS_STACK_GUARD
+#define STACK_ALIGNMENT         __attribute__((aligned(GUARD_PAGE_SIZE)))
+#else
+#define STACK_ALIGNMENT
+#endif
+
+/*************************************Defines***************************************/
+
+/********************************Public Functions***********************************/
+
+int32_t G8RTOS_InitStackGuard(void* stacks, uint32_t slotSize, uint32_t numberOfSlots);
+void G8RTOS_StackOverflowHook(threadID_t threadID);
+
+/********************************Public Functions***********************************/
+
+#endif /* G8RTOS_STACKGUARD_H_ */
@@ -20,6 +20,13 @@
 
 #define MAX_NAME_LENGTH             16
 
+// L1 data cache line size of the Cortex-A9
+#define CACHE_LINE_SIZE             32
+
+// tcb_t state flags
+#define TCB_STATE_ALIVE             0x01
+#define TCB_STATE_ASLEEP            0x02
+
 /*************************************Defines***************************************/
 
 /******************************Data Type Definitions********************************/
@@ -32,18 +39,29 @@ typedef int32_t threadID_t;
 /****************************Data Structure Definitions*****************************/
 
 // Thread Control Block
+// Only holds what the scheduler and context switch touch, packed into a
+// single cache line. stackPointer must stay the first member (PendSV_Handler).
 typedef struct tcb_t {
     uint32_t *stackPointer;
     struct tcb_t *nextTCB;
-    struct tcb_t *previousTCB;
     semaphore_t *blocked; //0 when thread is not blocked
+    uint32_t state; //TCB_STATE_* flags
     uint32_t sleepCount; //how much longer the thread will sleep for
-    bool asleep;
     uint8_t priority; //0 is highest priority
-    bool isAlive;
-    char threadName[MAX_NAME_LENGTH];
+    uint8_t partition; //time partition, see G8RTOS_Partitions.h
+    struct tcb_t *previousTCB;
     threadID_t ThreadID;
-}  tcb_t;
+} __attribute__((aligned(CACHE_LINE_SIZE))) tcb_t;
+
+_Static_assert(sizeof(tcb_t) == CACHE_LINE_SIZE, "tcb_t must fit one cache line");
+
+// Thread metadata, kept out of the scheduler's cache lines
+typedef struct tcbInfo_t {
+    char threadName[MAX_NAME_LENGTH];
+#ifdef G8RTOS_SWITCH_STATS
+    uint32_t switchCount; //times the thread has been switched in
+#endif
+} tcbInfo_t;
 
 // Periodic Thread Control Block
 typedef struct ptcb_t {
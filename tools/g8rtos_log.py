@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+# g8rtos_log.py
+# Formats the binary record stream of G8RTOS_LogDrainThread using the
+# format strings stored in the ELF's .g8rtos_log_strings section.
+#
+# Usage: g8rtos_log.py StarRTOS.elf capture.bin
+#        g8rtos_log.py StarRTOS.elf - < /dev/ttyUSB1
+
+import argparse
+import re
+import struct
+import sys
+
+LOG_MAGIC = 0xA5
+LOG_HEADER_WORDS = 3
+LOG_MAX_ARGS = 6
+LOG_NO_THREAD = 0xFFFF
+LOG_DROPPED_FORMAT = 0xFFFFFFFF
+STRINGS_SECTION = ".g8rtos_log_strings"
+
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|t|j)?([diuxXocsp%])")
+
+
+def load_strings(elf):
+    """Returns the (address, bytes) of the format string section of an ELF32."""
+    with open(elf, "rb") as f:
+        data = f.read()
+    if data[:4] != b"\x7fELF" or data[4] != 1:
+        sys.exit("%s is not an ELF32 file" % elf)
+    endian = "<" if data[5] == 1 else ">"
+    shoff, = struct.unpack_from(endian + "I", data, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", data, 0x2E)
+
+    def section(index):
+        return struct.unpack_from(endian + "IIIIIIIIII", data, shoff + index * shentsize)
+
+    names_offset = section(shstrndx)[4]
+    for i in range(shnum):
+        name, _, _, address, offset, size = section(i)[:6]
+        end = data.index(b"\0", names_offset + name)
+        if data[names_offset + name:end].decode() == STRINGS_SECTION:
+            return address, data[offset:offset + size]
+    sys.exit("%s has no %s section" % (elf, STRINGS_SECTION))
+
+
+def format_record(fmt, args):
+    """Applies a C format string to raw 32-bit arguments."""
+    args = list(args)
+
+    def convert(match):
+        flags, _, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        value = args.pop(0) if args else 0
+        if conversion in "di":
+            value -= (value & 0x80000000) << 1
+        elif conversion == "c":
+            value = chr(value & 0xFF)
+        elif conversion in "sp":
+            return "0x%08x" % value
+        return ("%" + flags + conversion.replace("u", "d")) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def read_records(stream):
+    """Yields (thread, time, format ID, args), resynchronizing on the magic byte."""
+    buffer = b""
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            return
+        buffer += chunk
+        while len(buffer) >= 4 * LOG_HEADER_WORDS:
+            header, = struct.unpack_from("<I", buffer)
+            argc = (header >> 16) & 0xFF
+            if header >> 24 != LOG_MAGIC or argc > LOG_MAX_ARGS:
+                buffer = buffer[1:]
+                continue
+            size = 4 * (LOG_HEADER_WORDS + argc)
+            if len(buffer) < size:
+                break
+            words = struct.unpack_from("<%dI" % (LOG_HEADER_WORDS + argc), buffer)
+            buffer = buffer[size:]
+            yield header & 0xFFFF, words[1], words[2], words[3:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Format a G8RTOS binary log")
+    parser.add_argument("elf")
+    parser.add_argument("capture", help="binary capture file, - for stdin")
+    args = parser.parse_args()
+
+    base, strings = load_strings(args.elf)
+    stream = sys.stdin.buffer if args.capture == "-" else open(args.capture, "rb")
+
+    for thread, time, format_id, values in read_records(stream):
+        source = "-" if thread == LOG_NO_THREAD else str(thread)
+        if format_id == LOG_DROPPED_FORMAT:
+            text = "<%d records dropped>" % values[0]
+        elif 0 <= format_id - base < len(strings):
+            offset = format_id - base
+            fmt = strings[offset:strings.index(b"\0", offset)].decode(errors="replace")
+            text = format_record(fmt, values)
+        else:
+            text = "<unknown format 0x%08x> %s" % (format_id, " ".join("%08x" % v for v in values))
+        print("%10d [%s] %s" % (time, source, text), flush=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+# g8rtos_profile.py
+# Symbolizes the output of G8RTOS_ProfilerDump against the application ELF
+# and prints flat and per-thread profiles.
+#
+# Usage: g8rtos_profile.py StarRTOS.elf dump.txt [--nm arm-none-eabi-nm] [--top N]
+
+import argparse
+import bisect
+import subprocess
+import sys
+from collections import defaultdict
+
+
+def load_symbols(elf, nm):
+    """Returns sorted (address, name) pairs for the ELF's code symbols."""
+    output = subprocess.run([nm, "-n", "--defined-only", elf],
+                            check=True, capture_output=True, text=True).stdout
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[1] in "tTwW":
+            # Clear the Thumb bit so addresses line up with sampled PCs
+            symbols.append((int(fields[0], 16) & ~1, fields[2]))
+    symbols.sort()
+    return symbols
+
+
+def parse_dump(lines):
+    header = None
+    regions = []
+    names = {}
+    samples = []
+    for line in lines:
+        fields = line.strip().split()
+        if not fields:
+            continue
+        if fields[0] == "G8RTOS_PROFILE":
+            header = [int(f) for f in fields[1:5]]
+            regions, names, samples = [], {}, []
+        elif header is None:
+            continue
+        elif fields[0] == "R":
+            regions.append((int(fields[1], 16), int(fields[2], 16), int(fields[3])))
+        elif fields[0] == "T":
+            names[int(fields[1])] = " ".join(fields[2:])
+        elif fields[0] == "S":
+            samples.append(tuple(int(f) for f in fields[1:4]))
+        elif fields[0] == "END":
+            break
+    if header is None:
+        sys.exit("no G8RTOS_PROFILE block found")
+    return header, regions, names, samples
+
+
+def bucket_address(bucket, regions, shift):
+    for start, end, first in regions:
+        buckets = ((end - start) >> shift) + 1
+        if first <= bucket < first + buckets:
+            return start + ((bucket - first) << shift)
+    return None
+
+
+def symbolize(address, symbols, addresses):
+    if address is None:
+        return "<unknown>"
+    i = bisect.bisect_right(addresses, address) - 1
+    return symbols[i][1] if i >= 0 else "0x%08x" % address
+
+
+def print_table(title, counts, total, top):
+    print(title)
+    print("  %8s %7s  %s" % ("samples", "percent", "function"))
+    for name, count in sorted(counts.items(), key=lambda c: -c[1])[:top]:
+        print("  %8d %6.2f%%  %s" % (count, 100.0 * count / total, name))
+    print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Symbolize a G8RTOS profiler dump")
+    parser.add_argument("elf")
+    parser.add_argument("dump")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--top", type=int, default=20)
+    args = parser.parse_args()
+
+    symbols = load_symbols(args.elf, args.nm)
+    addresses = [a for a, _ in symbols]
+    with open(args.dump) as f:
+        (rate, shift, sample_count, dropped), regions, names, samples = parse_dump(f)
+
+    flat = defaultdict(int)
+    per_thread = defaultdict(lambda: defaultdict(int))
+    for row, bucket, count in samples:
+        function = symbolize(bucket_address(bucket, regions, shift), symbols, addresses)
+        flat[function] += count
+        per_thread[row][function] += count
+
+    total = sum(flat.values()) or 1
+    print("%d samples at %d Hz, %d dropped, %d-byte buckets\n"
+          % (sample_count, rate, dropped, 1 << shift))
+    print_table("Flat profile", flat, total, args.top)
+    for row in sorted(per_thread):
+        thread_total = sum(per_thread[row].values())
+        name = names.get(row, "exited")
+        print_table("Thread %d (%s): %d samples" % (row, name, thread_total),
+                    per_thread[row], thread_total, args.top)
+
+
+if __name__ == "__main__":
+    main()